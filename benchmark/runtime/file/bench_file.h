@@ -0,0 +1,89 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#ifndef SCN_BENCHMARK_FILE_H
+#define SCN_BENCHMARK_FILE_H
+
+#include "../benchmark.h"
+
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#define FILE_DATA_N (static_cast<size_t>(2 << 16))
+
+// A file filled with whitespace-separated integers,
+// removed when the benchmark exits
+template <typename Int>
+class integer_list_file {
+public:
+    integer_list_file()
+    {
+        static std::uniform_int_distribution<Int> dist(
+            std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max());
+
+        std::ostringstream oss;
+        for (size_t i = 0; i < FILE_DATA_N; ++i) {
+            oss << dist(get_rng()) << '\n';
+        }
+        auto data = std::move(oss).str();
+
+        auto f = std::fopen(path(), "w");
+        std::fwrite(data.data(), 1, data.size(), f);
+        std::fclose(f);
+    }
+
+    integer_list_file(const integer_list_file&) = delete;
+    integer_list_file& operator=(const integer_list_file&) = delete;
+
+    ~integer_list_file()
+    {
+        std::remove(path());
+    }
+
+    static const char* path()
+    {
+        static const std::string p =
+            std::string{"scn_bench_file_"} +
+            (std::numeric_limits<Int>::is_signed ? "i" : "u") +
+            std::to_string(sizeof(Int) * 8) + ".txt";
+        return p.c_str();
+    }
+};
+
+template <typename Int>
+const char* get_integer_list_file()
+{
+    static integer_list_file<Int> f;
+    return f.path();
+}
+
+inline int fscanf_integral(std::FILE* f, int& i)
+{
+    return std::fscanf(f, "%d", &i);
+}
+inline int fscanf_integral(std::FILE* f, long long& i)
+{
+    return std::fscanf(f, "%lld", &i);
+}
+inline int fscanf_integral(std::FILE* f, unsigned& i)
+{
+    return std::fscanf(f, "%u", &i);
+}
+
+#endif  // SCN_BENCHMARK_FILE_H
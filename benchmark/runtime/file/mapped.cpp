@@ -0,0 +1,143 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_file.h"
+
+#if SCN_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+// Every iteration maps and scans the entire file, with the hint selected by
+// the benchmark argument
+enum mapped_file_hint {
+    hint_none,
+    hint_sequential,
+    hint_will_need,
+    hint_huge_pages,
+    hint_populate,
+    hint_drop_consumed,
+};
+
+static scn::mapped_file_options make_mapped_file_options(int hint)
+{
+    scn::mapped_file_options opt{};
+    switch (hint) {
+        case hint_sequential:
+            opt.sequential = true;
+            break;
+        case hint_will_need:
+            opt.will_need = true;
+            break;
+        case hint_huge_pages:
+            opt.huge_pages = true;
+            break;
+        case hint_populate:
+            opt.populate = true;
+            break;
+        case hint_drop_consumed:
+            opt.sequential = true;
+            opt.drop_consumed = true;
+            break;
+        default:
+            break;
+    }
+    return opt;
+}
+
+static const char* mapped_file_hint_name(int hint)
+{
+    switch (hint) {
+        case hint_sequential:
+            return "sequential";
+        case hint_will_need:
+            return "will_need";
+        case hint_huge_pages:
+            return "huge_pages";
+        case hint_populate:
+            return "populate";
+        case hint_drop_consumed:
+            return "sequential+drop_consumed";
+        default:
+            return "none";
+    }
+}
+
+// Drops the file from the page cache, so that the next mapping of it
+// has to read it from disk
+static void evict_from_page_cache(const char* path)
+{
+    int fd = ::open(path, O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    ::fdatasync(fd);
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+}
+
+template <typename Int>
+static void scan_int_mapped_file_hint(benchmark::State& state, bool cold)
+{
+    const auto path = get_integer_list_file<Int>();
+    const auto hint = static_cast<int>(state.range(0));
+    const auto opt = make_mapped_file_options(hint);
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        if (cold) {
+            state.PauseTiming();
+            evict_from_page_cache(path);
+            state.ResumeTiming();
+        }
+
+        scn::mapped_file file{path, opt};
+        auto result = scn::make_result(file);
+        Int i{};
+        while (true) {
+            result = scn::scan_default(result.range(), i);
+            if (!result) {
+                break;
+            }
+            benchmark::DoNotOptimize(i);
+            file.discard_until(result.range().data());
+        }
+        if (result.error() != scn::error::end_of_range) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        bytes += file.size();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetLabel(mapped_file_hint_name(hint));
+}
+
+template <typename Int>
+static void scan_int_mapped_file_cold(benchmark::State& state)
+{
+    scan_int_mapped_file_hint<Int>(state, true);
+}
+template <typename Int>
+static void scan_int_mapped_file_warm(benchmark::State& state)
+{
+    scan_int_mapped_file_hint<Int>(state, false);
+}
+
+BENCHMARK_TEMPLATE(scan_int_mapped_file_cold, int)
+    ->DenseRange(hint_none, hint_drop_consumed);
+BENCHMARK_TEMPLATE(scan_int_mapped_file_warm, int)
+    ->DenseRange(hint_none, hint_drop_consumed);
+#endif
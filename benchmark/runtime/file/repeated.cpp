@@ -0,0 +1,255 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_file.h"
+
+template <typename Int>
+static void scan_int_file_scn(benchmark::State& state)
+{
+    scn::owning_file file{get_integer_list_file<Int>(), "r"};
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                file.sync();
+                std::rewind(file.handle());
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_file_scn, int);
+BENCHMARK_TEMPLATE(scan_int_file_scn, long long);
+BENCHMARK_TEMPLATE(scan_int_file_scn, unsigned);
+
+// The same file, read as UTF-8 and decoded to wchar_t
+template <typename Int>
+static void scan_int_wfile_scn(benchmark::State& state)
+{
+    scn::owning_wfile file{get_integer_list_file<Int>(), "r"};
+    file.set_utf8();
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                file.sync();
+                std::rewind(file.handle());
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_wfile_scn, int);
+BENCHMARK_TEMPLATE(scan_int_wfile_scn, long long);
+BENCHMARK_TEMPLATE(scan_int_wfile_scn, unsigned);
+
+#if SCN_POSIX
+// A pipe can't be read in blocks, so it's read one character at a time
+template <typename Int>
+static void scan_int_file_scn_pipe(benchmark::State& state)
+{
+    auto cmd = std::string{"cat "} + get_integer_list_file<Int>();
+    scn::file file{popen(cmd.c_str(), "r")};
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                file.sync();
+                pclose(file.set_handle(popen(cmd.c_str(), "r"), false));
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    pclose(file.set_handle(nullptr));
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_file_scn_pipe, int);
+BENCHMARK_TEMPLATE(scan_int_file_scn_pipe, long long);
+BENCHMARK_TEMPLATE(scan_int_file_scn_pipe, unsigned);
+#endif
+
+template <typename Int>
+static void scan_int_file_scn_fd(benchmark::State& state)
+{
+    scn::owning_fd_file file{get_integer_list_file<Int>()};
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                file.close();
+                file.open(get_integer_list_file<Int>());
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_file_scn_fd, int);
+BENCHMARK_TEMPLATE(scan_int_file_scn_fd, long long);
+BENCHMARK_TEMPLATE(scan_int_file_scn_fd, unsigned);
+
+#if SCN_HAS_READAHEAD_FILE
+template <typename Int>
+static void scan_int_file_scn_readahead(benchmark::State& state)
+{
+    scn::readahead_file file{get_integer_list_file<Int>()};
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                file = scn::readahead_file{get_integer_list_file<Int>()};
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_file_scn_readahead, int);
+BENCHMARK_TEMPLATE(scan_int_file_scn_readahead, long long);
+BENCHMARK_TEMPLATE(scan_int_file_scn_readahead, unsigned);
+#endif
+
+template <typename Int>
+static void scan_int_file_scn_uring(benchmark::State& state)
+{
+    scn::uring_file_options opt{};
+    opt.disable_io_uring = state.range(0) == 0;
+    scn::uring_file file{get_integer_list_file<Int>(), opt};
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                file = scn::uring_file{get_integer_list_file<Int>(), opt};
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+    state.SetLabel(file.uses_io_uring() ? "io_uring" : "pread");
+}
+BENCHMARK_TEMPLATE(scan_int_file_scn_uring, int)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(scan_int_file_scn_uring, long long)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(scan_int_file_scn_uring, unsigned)->Arg(0)->Arg(1);
+
+template <typename Int>
+static void scan_int_file_scn_mapped(benchmark::State& state)
+{
+    scn::mapped_file file{get_integer_list_file<Int>()};
+    Int i{};
+    auto result = scn::make_result(file);
+    for (auto _ : state) {
+        result = scn::scan_default(result.range(), i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(file);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_file_scn_mapped, int);
+BENCHMARK_TEMPLATE(scan_int_file_scn_mapped, long long);
+BENCHMARK_TEMPLATE(scan_int_file_scn_mapped, unsigned);
+
+template <typename Int>
+static void scan_int_file_fscanf(benchmark::State& state)
+{
+    auto f = std::fopen(get_integer_list_file<Int>(), "r");
+    Int i{};
+    for (auto _ : state) {
+        auto ret = fscanf_integral(f, i);
+
+        if (ret != 1) {
+            if (ret == EOF) {
+                std::rewind(f);
+                continue;
+            }
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    std::fclose(f);
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations()) *
+        static_cast<int64_t>(sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_file_fscanf, int);
+BENCHMARK_TEMPLATE(scan_int_file_fscanf, long long);
+BENCHMARK_TEMPLATE(scan_int_file_fscanf, unsigned);
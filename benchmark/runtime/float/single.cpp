@@ -117,6 +117,35 @@ BENCHMARK_TEMPLATE(scan_float_single_scn_parse, float);
 BENCHMARK_TEMPLATE(scan_float_single_scn_parse, double);
 BENCHMARK_TEMPLATE(scan_float_single_scn_parse, long double);
 
+template <typename Float>
+static void scan_float_single_scn_parse_wide(benchmark::State& state)
+{
+    std::vector<std::wstring> source;
+    for (const auto& s : stringified_floats_list<Float>()) {
+        source.emplace_back(s.begin(), s.end());
+    }
+    auto it = source.begin();
+    Float f{};
+    for (auto _ : state) {
+        if (it == source.end()) {
+            it = source.begin();
+        }
+
+        auto result = scn::parse_float<Float>(
+            scn::wstring_view{it->data(), it->size()}, f);
+
+        if (!result) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Float)));
+}
+BENCHMARK_TEMPLATE(scan_float_single_scn_parse_wide, float);
+BENCHMARK_TEMPLATE(scan_float_single_scn_parse_wide, double);
+BENCHMARK_TEMPLATE(scan_float_single_scn_parse_wide, long double);
+
 template <typename Float>
 static void scan_float_single_sstream(benchmark::State& state)
 {
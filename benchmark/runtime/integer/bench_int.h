@@ -20,9 +20,11 @@
 
 #include "../benchmark.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <limits>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #define INT_DATA_N (static_cast<size_t>(2 << 12))
@@ -41,6 +43,31 @@ std::vector<std::string> stringified_integers_list(size_t n = INT_DATA_N)
     return ret;
 }
 
+// Non-negative integers with exactly `digits` decimal digits,
+// or as many as Int can hold, if less
+template <typename Int>
+std::vector<std::string> stringified_integers_list_of_length(
+    int digits,
+    size_t n = INT_DATA_N)
+{
+    digits = std::min(digits, std::numeric_limits<Int>::digits10 + 1);
+    Int min = 1;
+    for (int i = 1; i < digits; ++i) {
+        min = static_cast<Int>(min * 10);
+    }
+    const Int max = digits > std::numeric_limits<Int>::digits10
+                        ? std::numeric_limits<Int>::max()
+                        : static_cast<Int>(min * 10 - 1);
+    std::uniform_int_distribution<Int> dist(digits == 1 ? Int{0} : min, max);
+    std::vector<std::string> ret;
+    for (size_t i = 0; i < n; ++i) {
+        std::ostringstream oss;
+        oss << dist(get_rng());
+        ret.push_back(std::move(oss).str());
+    }
+    return ret;
+}
+
 template <typename Int>
 std::string stringified_integer_list(size_t n = INT_DATA_N,
                                      const char* delim = " ")
@@ -55,6 +82,28 @@ std::string stringified_integer_list(size_t n = INT_DATA_N,
     return oss.str();
 }
 
+// Like stringified_integer_list, with ',' between groups of three digits
+template <typename Int>
+std::string stringified_grouped_integer_list(size_t n = INT_DATA_N,
+                                             const char* delim = " ")
+{
+    static std::uniform_int_distribution<Int> dist(
+        std::numeric_limits<Int>::min(), std::numeric_limits<Int>::max());
+
+    std::string ret;
+    for (size_t i = 0; i < n; ++i) {
+        auto digits = std::to_string(dist(get_rng()));
+        const auto sign = digits[0] == '-' ? size_t{1} : size_t{0};
+        for (auto pos = digits.size(); pos > sign + 3;) {
+            pos -= 3;
+            digits.insert(pos, 1, ',');
+        }
+        ret += digits;
+        ret += delim;
+    }
+    return ret;
+}
+
 inline int scanf_integral(const char* ptr, int& i)
 {
     return sscanf(ptr, "%d", &i);
@@ -0,0 +1,115 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_int.h"
+
+// Records of three right-aligned, space-padded columns,
+// 8, 8 and 4 characters wide, with no separators in between
+static std::string fixed_width_records(size_t n = INT_DATA_N)
+{
+    std::uniform_int_distribution<int> wide(-9999999, 99999999);
+    std::uniform_int_distribution<int> narrow(-999, 9999);
+
+    std::string ret;
+    char buf[32];
+    for (size_t i = 0; i < n; ++i) {
+        std::snprintf(buf, sizeof(buf), "%8d%8d%4d", wide(get_rng()),
+                      wide(get_rng()), narrow(get_rng()));
+        ret += buf;
+    }
+    return ret;
+}
+
+// Same layout, with floating-point values
+static std::string fixed_width_float_records(size_t n = INT_DATA_N)
+{
+    std::uniform_real_distribution<double> wide(-9999.0, 99999.0);
+    std::uniform_real_distribution<double> narrow(-9.0, 99.0);
+
+    std::string ret;
+    char buf[32];
+    for (size_t i = 0; i < n; ++i) {
+        std::snprintf(buf, sizeof(buf), "%8.2f%8.2f%4.1f", wide(get_rng()),
+                      wide(get_rng()), narrow(get_rng()));
+        ret += buf;
+    }
+    return ret;
+}
+
+template <typename T>
+static void scan_fixed_width_scn(benchmark::State& state,
+                                 const std::string& data)
+{
+    T a{}, b{}, c{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan(result.range(), "{:8}{:8}{:4}", a, b, c);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * 20));
+}
+
+static void scan_int_fixed_width_scn(benchmark::State& state)
+{
+    scan_fixed_width_scn<int>(state, fixed_width_records());
+}
+BENCHMARK(scan_int_fixed_width_scn);
+
+static void scan_float_fixed_width_scn(benchmark::State& state)
+{
+    scan_fixed_width_scn<double>(state, fixed_width_float_records());
+}
+BENCHMARK(scan_float_fixed_width_scn);
+
+static void scan_int_fixed_width_scanf(benchmark::State& state)
+{
+    auto data = fixed_width_records();
+    int a{}, b{}, c{};
+    auto ptr = &data[0];
+    const auto end = ptr + data.size();
+    for (auto _ : state) {
+        auto ret = sscanf(ptr, "%8d%8d%4d", &a, &b, &c);
+        ptr += 20;
+
+        if (ret != 3) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        if (ptr == end) {
+            ptr = &data[0];
+        }
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(c);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * 20));
+}
+BENCHMARK(scan_int_fixed_width_scanf);
@@ -0,0 +1,113 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+#include "bench_int.h"
+
+#include <cerrno>
+#include <cstdlib>
+
+// Values of a fixed number of digits, given by the benchmark argument.
+// 20 is clamped to the maximum length of Int.
+
+template <typename Int>
+static void scan_int_length_scn(benchmark::State& state)
+{
+    const auto digits = static_cast<int>(state.range(0));
+    auto source = stringified_integers_list_of_length<Int>(digits);
+    auto it = source.begin();
+    Int i;
+    for (auto _ : state) {
+        if (it == source.end()) {
+            it = source.begin();
+        }
+
+        auto result = scn::scan_default(*it, i);
+        ++it;
+
+        if (!result) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        benchmark::DoNotOptimize(i);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_length_scn, int)->Arg(2)->Arg(5)->Arg(20);
+BENCHMARK_TEMPLATE(scan_int_length_scn, long long)->Arg(2)->Arg(10)->Arg(20);
+BENCHMARK_TEMPLATE(scan_int_length_scn, unsigned)->Arg(2)->Arg(5)->Arg(20);
+
+template <typename Int>
+static void scan_int_length_parse(benchmark::State& state)
+{
+    const auto digits = static_cast<int>(state.range(0));
+    auto source = stringified_integers_list_of_length<Int>(digits);
+    auto it = source.begin();
+    Int i;
+    for (auto _ : state) {
+        if (it == source.end()) {
+            it = source.begin();
+        }
+
+        auto result = scn::parse_integer<Int>(
+            scn::string_view{it->data(), it->size()}, i);
+        ++it;
+
+        if (!result) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        benchmark::DoNotOptimize(i);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_length_parse, int)->Arg(2)->Arg(5)->Arg(20);
+BENCHMARK_TEMPLATE(scan_int_length_parse, long long)
+    ->Arg(2)
+    ->Arg(10)
+    ->Arg(20);
+BENCHMARK_TEMPLATE(scan_int_length_parse, unsigned)->Arg(2)->Arg(5)->Arg(20);
+
+template <typename Int>
+static void scan_int_length_strtol(benchmark::State& state)
+{
+    const auto digits = static_cast<int>(state.range(0));
+    auto source = stringified_integers_list_of_length<Int>(digits);
+    auto it = source.begin();
+    for (auto _ : state) {
+        if (it == source.end()) {
+            it = source.begin();
+        }
+
+        errno = 0;
+        auto i = std::strtoll(it->c_str(), nullptr, 10);
+        ++it;
+
+        if (errno != 0) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        benchmark::DoNotOptimize(i);
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_length_strtol, long long)
+    ->Arg(2)
+    ->Arg(10)
+    ->Arg(20);
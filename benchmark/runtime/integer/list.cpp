@@ -113,6 +113,26 @@ static void scan_int_list_scn_list(benchmark::State& state)
 }
 BENCHMARK(scan_int_list_scn_list)->Arg(16)->Arg(64)->Arg(256);
 
+static void scan_int_list_scn_parse_integers(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    auto data = stringified_integer_list<int>(n);
+    std::vector<int> read(n);
+
+    for (auto _ : state) {
+        auto result = scn::parse_integers(
+            scn::string_view{data.data(), data.size()}, scn::make_span(read));
+        if (!result || result.count != n) {
+            state.SkipWithError("Benchmark errored");
+            break;
+        }
+        benchmark::DoNotOptimize(read.data());
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * n * sizeof(int)));
+}
+BENCHMARK(scan_int_list_scn_parse_integers)->Arg(16)->Arg(64)->Arg(256);
+
 static void scan_int_list_sstream(benchmark::State& state)
 {
     const auto n = static_cast<size_t>(state.range(0));
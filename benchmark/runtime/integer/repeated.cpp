@@ -43,6 +43,58 @@ BENCHMARK_TEMPLATE(scan_int_repeated_scn, int);
 BENCHMARK_TEMPLATE(scan_int_repeated_scn, long long);
 BENCHMARK_TEMPLATE(scan_int_repeated_scn, unsigned);
 
+template <typename Int>
+static void scan_int_repeated_scn_localized(benchmark::State& state)
+{
+    auto data = stringified_integer_list<Int>();
+    Int i{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan(result.range(), "{:n}", i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_localized, int);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_localized, long long);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_localized, unsigned);
+
+template <typename Int>
+static void scan_int_repeated_scn_thsep(benchmark::State& state)
+{
+    auto data = stringified_grouped_integer_list<Int>();
+    Int i{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan(result.range(), "{:'}", i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_thsep, int);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_thsep, long long);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_thsep, unsigned);
+
 template <typename Int>
 static void scan_int_repeated_scn_default(benchmark::State& state)
 {
@@ -69,6 +121,32 @@ BENCHMARK_TEMPLATE(scan_int_repeated_scn_default, int);
 BENCHMARK_TEMPLATE(scan_int_repeated_scn_default, long long);
 BENCHMARK_TEMPLATE(scan_int_repeated_scn_default, unsigned);
 
+template <typename Int>
+static void scan_int_repeated_scn_integer_format(benchmark::State& state)
+{
+    auto data = stringified_integer_list<Int>();
+    Int i{};
+    auto result = scn::make_result(data);
+    for (auto _ : state) {
+        result = scn::scan(result.range(), scn::integer_format<10>{}, i);
+
+        if (!result) {
+            if (result.error() == scn::error::end_of_range) {
+                result = scn::make_result(data);
+            }
+            else {
+                state.SkipWithError("Benchmark errored");
+                break;
+            }
+        }
+    }
+    state.SetBytesProcessed(
+        static_cast<int64_t>(state.iterations() * sizeof(Int)));
+}
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_integer_format, int);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_integer_format, long long);
+BENCHMARK_TEMPLATE(scan_int_repeated_scn_integer_format, unsigned);
+
 template <typename Int>
 static void scan_int_repeated_scn_value(benchmark::State& state)
 {
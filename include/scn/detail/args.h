@@ -94,16 +94,26 @@ namespace scn {
             string_view_type,
 
             custom_type,
-            last_type = custom_type
+
+            // 128-bit integers, only used if SCN_HAS_INT128.
+            // Always declared, and last, so that the values of the other
+            // types don't depend on it: it's different in strict ISO mode,
+            // and the library may be built in a different mode than the
+            // code using it.
+            int128_type,
+            uint128_type,
+            last_type = uint128_type
         };
 
         constexpr bool is_integral(type t) noexcept
         {
-            return t > none_type && t <= last_integer_type;
+            return (t > none_type && t <= last_integer_type) ||
+                   t == int128_type || t == uint128_type;
         }
         constexpr bool is_arithmetic(type t) noexcept
         {
-            return t > none_type && t <= last_numeric_type;
+            return (t > none_type && t <= last_numeric_type) ||
+                   t == int128_type || t == uint128_type;
         }
 
         struct custom_value {
@@ -224,12 +234,18 @@ namespace scn {
         SCN_MAKE_VALUE(int_type, int)
         SCN_MAKE_VALUE(long_type, long)
         SCN_MAKE_VALUE(long_long_type, long long)
+#if SCN_HAS_INT128
+        SCN_MAKE_VALUE(int128_type, int128)
+#endif
 
         SCN_MAKE_VALUE(uchar_type, unsigned char)
         SCN_MAKE_VALUE(ushort_type, unsigned short)
         SCN_MAKE_VALUE(uint_type, unsigned)
         SCN_MAKE_VALUE(ulong_type, unsigned long)
         SCN_MAKE_VALUE(ulong_long_type, unsigned long long)
+#if SCN_HAS_INT128
+        SCN_MAKE_VALUE(uint128_type, uint128)
+#endif
 
         SCN_MAKE_VALUE(bool_type, bool)
         SCN_MAKE_VALUE(code_point_type, code_point)
@@ -347,6 +363,10 @@ namespace scn {
                 return vis(arg.m_value.template get_as<long>());
             case detail::long_long_type:
                 return vis(arg.m_value.template get_as<long long>());
+#if SCN_HAS_INT128
+            case detail::int128_type:
+                return vis(arg.m_value.template get_as<int128>());
+#endif
 
             case detail::uchar_type:
                 return vis(arg.m_value.template get_as<unsigned char>());
@@ -358,6 +378,10 @@ namespace scn {
                 return vis(arg.m_value.template get_as<unsigned long>());
             case detail::ulong_long_type:
                 return vis(arg.m_value.template get_as<unsigned long long>());
+#if SCN_HAS_INT128
+            case detail::uint128_type:
+                return vis(arg.m_value.template get_as<uint128>());
+#endif
 
             case detail::bool_type:
                 return vis(arg.m_value.template get_as<bool>());
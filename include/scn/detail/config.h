@@ -112,6 +112,14 @@
 #define SCN_WINDOWS 0
 #endif
 
+// Byte order, assumed little-endian unless known otherwise
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define SCN_IS_BIG_ENDIAN 1
+#else
+#define SCN_IS_BIG_ENDIAN 0
+#endif
+
 #ifdef _MSVC_LANG
 #define SCN_MSVC_LANG _MSVC_LANG
 #else
@@ -332,6 +340,23 @@
 #define SCN_HAS_FLOAT_CHARCONV   0
 #endif
 
+// Detect __int128
+// The standard library only treats it as an integral type
+// (is_integral, make_unsigned, numeric_limits) outside of strict ISO mode
+#ifndef SCN_HAS_INT128
+#if defined(__SIZEOF_INT128__) && !SCN_MSVC && !defined(__STRICT_ANSI__)
+#define SCN_HAS_INT128 1
+#else
+#define SCN_HAS_INT128 0
+#endif
+#endif
+
+// basic_readahead_file needs threads: enabled with the CMake option
+// SCN_USE_READAHEAD_FILE
+#ifndef SCN_HAS_READAHEAD_FILE
+#define SCN_HAS_READAHEAD_FILE 0
+#endif
+
 // Detect std::launder
 #if defined(__cpp_lib_launder) && __cpp_lib_launder >= 201606
 #define SCN_HAS_LAUNDER 1
@@ -18,15 +18,40 @@
 #ifndef SCN_DETAIL_FILE_H
 #define SCN_DETAIL_FILE_H
 
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <string>
 
 #include "../util/algorithm.h"
+#include "../util/expected.h"
 #include "range.h"
 
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
+    /**
+     * Hints on how a memory-mapped file is going to be accessed.
+     * None of them change the contents of the mapping,
+     * and they're ignored where not supported by the platform.
+     * By default, no hints are given.
+     */
+    struct mapped_file_options {
+        /// Pages will be accessed in order: read ahead aggressively
+        /// (`MADV_SEQUENTIAL`)
+        bool sequential{false};
+        /// The entire file will be needed soon: start reading it in
+        /// (`MADV_WILLNEED`)
+        bool will_need{false};
+        /// Back the mapping with huge pages (`MADV_HUGEPAGE`)
+        bool huge_pages{false};
+        /// Fault in the entire mapping when it's created (`MAP_POPULATE`)
+        bool populate{false};
+        /// Make `discard_until()` release pages already consumed
+        /// (`MADV_DONTNEED`)
+        bool drop_consumed{false};
+    };
+
     namespace detail {
         struct native_file_handle {
 #if SCN_WINDOWS
@@ -46,14 +71,21 @@ namespace scn {
             using sentinel = const char*;
 
             byte_mapped_file() = default;
-            explicit byte_mapped_file(const char* filename);
+            explicit byte_mapped_file(const char* filename)
+                : byte_mapped_file(filename, mapped_file_options{})
+            {
+            }
+            byte_mapped_file(const char* filename,
+                             const mapped_file_options& opt);
 
             byte_mapped_file(const byte_mapped_file&) = delete;
             byte_mapped_file& operator=(const byte_mapped_file&) = delete;
 
             byte_mapped_file(byte_mapped_file&& o) noexcept
                 : m_map(exchange(o.m_map, span<char>{})),
-                  m_file(exchange(o.m_file, native_file_handle::invalid()))
+                  m_file(exchange(o.m_file, native_file_handle::invalid())),
+                  m_discarded(exchange(o.m_discarded, nullptr)),
+                  m_drop_consumed(exchange(o.m_drop_consumed, false))
             {
 #if SCN_WINDOWS
                 m_map_handle =
@@ -70,6 +102,8 @@ namespace scn {
 
                 m_map = exchange(o.m_map, span<char>{});
                 m_file = exchange(o.m_file, native_file_handle::invalid());
+                m_discarded = exchange(o.m_discarded, nullptr);
+                m_drop_consumed = exchange(o.m_drop_consumed, false);
 #if SCN_WINDOWS
                 m_map_handle =
                     exchange(o.m_map_handle, native_file_handle::invalid());
@@ -101,16 +135,46 @@ namespace scn {
                 return m_map.end();
             }
 
+            /**
+             * Release the pages before `it` from memory, if
+             * `mapped_file_options::drop_consumed` was set.
+             * They're read back in from the file if accessed again.
+             */
+            void discard_until(iterator it) const noexcept;
+
         protected:
             void _destruct();
 
             span<char> m_map{};
             native_file_handle m_file{native_file_handle::invalid().handle};
+            // Beginning of the pages not yet released by discard_until()
+            mutable const char* m_discarded{nullptr};
+            bool m_drop_consumed{false};
 #if SCN_WINDOWS
             native_file_handle m_map_handle{
                 native_file_handle::invalid().handle};
 #endif
         };
+
+        /// How a basic_file reads from its FILE*
+        enum class file_read_mode : unsigned char {
+            /// Not yet determined
+            unknown,
+            /// One character at a time, for pipes, ttys and the like
+            single,
+            /// In blocks of `file_block_size`, for regular files
+            block
+        };
+
+        /// Size of a single read, when reading a file in blocks
+        static constexpr std::size_t file_block_size = 4096;
+
+        /// Minimum number of consumed characters to discard at once, when
+        /// the buffer of a basic_file is windowed
+        static constexpr std::size_t file_window_discard_threshold =
+            file_block_size;
+
+        file_read_mode get_file_read_mode(FILE* f) noexcept;
     }  // namespace detail
 
     /**
@@ -130,6 +194,11 @@ namespace scn {
         explicit basic_mapped_file(const char* f) : detail::byte_mapped_file{f}
         {
         }
+        /// Constructs a mapping to a filename, with access hints
+        basic_mapped_file(const char* f, const mapped_file_options& opt)
+            : detail::byte_mapped_file{f, opt}
+        {
+        }
 
         SCN_NODISCARD iterator begin() const noexcept
         {
@@ -156,6 +225,13 @@ namespace scn {
             return {data(), size()};
         }
 
+        /// \see detail::byte_mapped_file::discard_until()
+        void discard_until(iterator it) const noexcept
+        {
+            byte_mapped_file::discard_until(
+                reinterpret_cast<byte_mapped_file::iterator>(it));
+        }
+
         detail::range_wrapper<basic_string_view<CharT>> wrap() const noexcept
         {
             return basic_string_view<CharT>{data(), size()};
@@ -168,22 +244,81 @@ namespace scn {
     namespace detail {
         template <typename CharT>
         struct basic_file_access;
-        template <typename CharT>
-        struct basic_file_iterator_access;
-    }  // namespace detail
+        template <typename File>
+        struct basic_file_iterator_access {
+            using iterator = typename File::iterator;
+            using char_type = typename File::char_type;
 
-    /**
-     * Range mapping to a C FILE*.
-     * Not copyable or reconstructible.
-     */
-    template <typename CharT>
-    class basic_file {
-        friend struct detail::basic_file_access<CharT>;
-        friend struct detail::basic_file_iterator_access<CharT>;
+            basic_file_iterator_access(const iterator& it) : self(it) {}
 
-    public:
-        class iterator {
-            friend struct detail::basic_file_iterator_access<CharT>;
+            SCN_NODISCARD expected<char_type> deref() const
+            {
+                SCN_EXPECT(self.m_file);
+
+                if (!self.m_last_error) {
+                    // last read failed
+                    return self.m_last_error;
+                }
+                if (self.m_file->_is_at_end(self.m_current)) {
+                    // no chars have been read at this position
+                    return self.m_file->_read_single();
+                }
+                return self.m_file->_get_char_at(self.m_current);
+            }
+
+            SCN_NODISCARD bool eq(const iterator& o) const
+            {
+                if (self.m_file && (self.m_file == o.m_file || !o.m_file)) {
+                    if (self.m_file->_is_at_end(self.m_current) &&
+                        self.m_last_error.code() != error::end_of_range &&
+                        !o.m_file) {
+                        self.m_last_error = error{};
+                        auto r = self.m_file->_read_single();
+                        if (!r) {
+                            self.m_last_error = r.error();
+                            return !o.m_file || self.m_current == o.m_current ||
+                                   o.m_last_error.code() == error::end_of_range;
+                        }
+                    }
+                }
+
+                // null file == null file
+                if (!self.m_file && !o.m_file) {
+                    return true;
+                }
+                // null file == eof file
+                if (!self.m_file && o.m_file) {
+                    // lhs null, rhs potentially eof
+                    return o.m_last_error.code() == error::end_of_range;
+                }
+                // eof file == null file
+                if (self.m_file && !o.m_file) {
+                    // rhs null, lhs potentially eof
+                    return self.m_last_error.code() == error::end_of_range;
+                }
+                // eof file == eof file
+                if (self.m_last_error == o.m_last_error &&
+                    self.m_last_error.code() == error::end_of_range) {
+                    return true;
+                }
+
+                return self.m_file == o.m_file && self.m_current == o.m_current;
+            }
+
+            const iterator& self;
+        };
+
+        /**
+         * Iterator into a range reading from a file in blocks.
+         * Identifies a character by its position in the file,
+         * and delegates everything else to the file type.
+         */
+        template <typename CharT,
+                  typename File,
+                  typename Position = std::size_t>
+        class basic_file_iterator {
+            friend struct basic_file_iterator_access<File>;
+            friend File;
 
         public:
             using char_type = CharT;
@@ -192,26 +327,29 @@ namespace scn {
             using pointer = value_type*;
             using difference_type = std::ptrdiff_t;
             using iterator_category = std::bidirectional_iterator_tag;
-            using file_type = basic_file<CharT>;
+            using file_type = File;
 
-            iterator() = default;
+            basic_file_iterator() = default;
 
-            expected<CharT> operator*() const;
+            expected<CharT> operator*() const
+            {
+                return basic_file_iterator_access<File>(*this).deref();
+            }
 
-            iterator& operator++()
+            basic_file_iterator& operator++()
             {
                 SCN_EXPECT(m_file);
                 ++m_current;
                 return *this;
             }
-            iterator operator++(int)
+            basic_file_iterator operator++(int)
             {
-                iterator tmp(*this);
+                basic_file_iterator tmp(*this);
                 operator++();
                 return tmp;
             }
 
-            iterator& operator--()
+            basic_file_iterator& operator--()
             {
                 SCN_EXPECT(m_file);
                 SCN_EXPECT(m_current > 0);
@@ -221,21 +359,23 @@ namespace scn {
 
                 return *this;
             }
-            iterator operator--(int)
+            basic_file_iterator operator--(int)
             {
-                iterator tmp(*this);
+                basic_file_iterator tmp(*this);
                 operator--();
                 return tmp;
             }
 
-            bool operator==(const iterator& o) const;
-
-            bool operator!=(const iterator& o) const
+            bool operator==(const basic_file_iterator& o) const
+            {
+                return basic_file_iterator_access<File>(*this).eq(o);
+            }
+            bool operator!=(const basic_file_iterator& o) const
             {
                 return !operator==(o);
             }
 
-            bool operator<(const iterator& o) const
+            bool operator<(const basic_file_iterator& o) const
             {
                 // any valid iterator is before eof and null
                 if (!m_file) {
@@ -247,37 +387,58 @@ namespace scn {
                 SCN_EXPECT(m_file == o.m_file);
                 return m_current < o.m_current;
             }
-            bool operator>(const iterator& o) const
+            bool operator>(const basic_file_iterator& o) const
             {
                 return o.operator<(*this);
             }
-            bool operator<=(const iterator& o) const
+            bool operator<=(const basic_file_iterator& o) const
             {
                 return !operator>(o);
             }
-            bool operator>=(const iterator& o) const
+            bool operator>=(const basic_file_iterator& o) const
             {
                 return !operator<(o);
             }
 
             void reset_begin_iterator() const noexcept
             {
-                m_current = 0;
+                m_current = m_file ? m_file->m_buffer_offset : 0;
             }
 
-        private:
-            friend class basic_file;
+            void set_rollback_point() const noexcept
+            {
+                if (m_file) {
+                    m_file->_set_rollback_point(m_current);
+                }
+            }
 
-            iterator(const file_type& f, size_t i)
+        private:
+            basic_file_iterator(const File& f, Position i)
                 : m_file{std::addressof(f)}, m_current{i}
             {
             }
 
             mutable error m_last_error{};
-            const file_type* m_file{nullptr};
-            mutable size_t m_current{0};
+            const File* m_file{nullptr};
+            mutable Position m_current{0};
         };
+    }  // namespace detail
+
+    /**
+     * Range mapping to a C FILE*.
+     * Not copyable or reconstructible.
+     *
+     * A `wfile` reads one character at a time with fgetwc(),
+     * decoding the file according to `LC_CTYPE`.
+     * If the file is known to be UTF-8, see set_utf8().
+     */
+    template <typename CharT>
+    class basic_file {
+        friend struct detail::basic_file_access<CharT>;
+        friend struct detail::basic_file_iterator_access<basic_file>;
 
+    public:
+        using iterator = detail::basic_file_iterator<CharT, basic_file>;
         using sentinel = iterator;
         using char_type = CharT;
 
@@ -297,8 +458,17 @@ namespace scn {
 
         basic_file(basic_file&& o) noexcept
             : m_buffer(detail::exchange(o.m_buffer, {})),
-              m_file(detail::exchange(o.m_file, nullptr))
+              m_file(detail::exchange(o.m_file, nullptr)),
+              m_consumed(detail::exchange(o.m_consumed, std::size_t{0})),
+              m_buffer_offset(
+                  detail::exchange(o.m_buffer_offset, std::size_t{0})),
+              m_read_mode(detail::exchange(o.m_read_mode,
+                                           detail::file_read_mode::unknown)),
+              m_windowed(detail::exchange(o.m_windowed, false)),
+              m_utf8(detail::exchange(o.m_utf8, false)),
+              m_carry_size(detail::exchange(o.m_carry_size, std::size_t{0}))
         {
+            std::memcpy(m_carry, o.m_carry, sizeof(m_carry));
         }
         basic_file& operator=(basic_file&& o) noexcept
         {
@@ -307,6 +477,15 @@ namespace scn {
             }
             m_buffer = detail::exchange(o.m_buffer, {});
             m_file = detail::exchange(o.m_file, nullptr);
+            m_consumed = detail::exchange(o.m_consumed, std::size_t{0});
+            m_buffer_offset =
+                detail::exchange(o.m_buffer_offset, std::size_t{0});
+            m_read_mode = detail::exchange(o.m_read_mode,
+                                           detail::file_read_mode::unknown);
+            m_windowed = detail::exchange(o.m_windowed, false);
+            m_utf8 = detail::exchange(o.m_utf8, false);
+            m_carry_size = detail::exchange(o.m_carry_size, std::size_t{0});
+            std::memcpy(m_carry, o.m_carry, sizeof(m_carry));
             return *this;
         }
 
@@ -322,6 +501,9 @@ namespace scn {
          * Only use this handle for reading sync() has been called and no
          * reading operations have taken place after that.
          *
+         * Regular files are read in blocks, so before sync(), the position
+         * of the handle can be up to a block past what has been scanned.
+         *
          * \see sync
          */
         FILE* handle() const
@@ -341,6 +523,7 @@ namespace scn {
                 sync();
             }
             m_file = f;
+            m_read_mode = detail::file_read_mode::unknown;
             return old;
         }
 
@@ -350,11 +533,80 @@ namespace scn {
             return m_file != nullptr;
         }
 
+        /**
+         * Enable or disable windowed buffering.
+         *
+         * By default, every character read from the FILE* is kept in the
+         * buffer until sync() is called.
+         * When windowed, characters before the rollback point
+         * (everything consumed by a successful scanning operation)
+         * are dropped from the buffer, so that its size doesn't grow with the
+         * size of the input.
+         *
+         * When windowed, iterators pointing before the rollback point are
+         * invalidated when a new rollback point is set,
+         * and begin() returns an iterator to the first character still in
+         * the buffer.
+         */
+        void set_windowed(bool windowed = true) noexcept
+        {
+            m_windowed = windowed;
+        }
+        /// Whether windowed buffering is enabled
+        SCN_NODISCARD bool windowed() const noexcept
+        {
+            return m_windowed;
+        }
+
+        /**
+         * Declare the file to be encoded in UTF-8, regardless of `LC_CTYPE`.
+         * Only affects a `wfile`, and must be set before anything is read.
+         *
+         * A regular file, which hasn't been set to wide orientation,
+         * is then read as bytes in blocks, and decoded from UTF-8 in bulk,
+         * instead of with fgetwc().
+         * The FILE* is left byte-oriented: after sync(), it has to be read
+         * with byte functions like fgets(), not with fgetws().
+         *
+         * basic_owning_file::open() sets a `wfile` to wide orientation,
+         * unless this has been called before it.
+         */
+        void set_utf8(bool utf8 = true) noexcept
+        {
+            m_utf8 = utf8;
+        }
+        /// Whether the file has been declared to be encoded in UTF-8
+        SCN_NODISCARD bool utf8() const noexcept
+        {
+            return m_utf8;
+        }
+
+        /// Number of characters the buffer can hold without reallocating
+        SCN_NODISCARD std::size_t buffer_capacity() const noexcept
+        {
+            return m_buffer.capacity();
+        }
+
         /**
          * Synchronizes this file with the underlying FILE*.
          * Invalidates all non-end iterators.
          * File must be open.
          *
+         * Characters read from the FILE*, but not consumed by a successful
+         * scanning operation, are given back to it.
+         * That includes any whitespace following the last scanned value.
+         *
+         * Regular files read in blocks are seeked back.
+         * Otherwise, the characters are pushed back with ungetc()
+         * (ungetwc() for a `wfile`), which is only guaranteed to work for a
+         * single character.
+         *
+         * @return `false`, if the characters couldn't be given back,
+         * because seeking or pushing back failed.
+         * The position of the FILE* is then unspecified.
+         * A `wfile` declared with set_utf8() can't push characters back,
+         * and fails if seeking fails.
+         *
          * Necessary for mixing-and-matching scnlib and <cstdio>:
          * \code{.cpp}
          * scn::scan(file, ...);
@@ -372,15 +624,18 @@ namespace scn {
          * result = scn::scan(file, ...);
          * \endcode
          */
-        void sync() noexcept
+        bool sync() noexcept
         {
-            _sync_all();
+            const auto ret = _sync_all();
             m_buffer.clear();
+            m_consumed = 0;
+            m_buffer_offset = 0;
+            return ret;
         }
 
         iterator begin() const noexcept
         {
-            return {*this, 0};
+            return {*this, m_buffer_offset};
         }
         sentinel end() const noexcept
         {
@@ -393,8 +648,10 @@ namespace scn {
             if (!it.m_file) {
                 return {};
             }
+            SCN_EXPECT(it.m_current >= m_buffer_offset);
             const auto begin =
-                m_buffer.begin() + static_cast<std::ptrdiff_t>(it.m_current);
+                m_buffer.begin() +
+                static_cast<std::ptrdiff_t>(it.m_current - m_buffer_offset);
             const auto end_diff = detail::min(
                 max_size,
                 static_cast<size_t>(ranges::distance(begin, m_buffer.end())));
@@ -402,53 +659,82 @@ namespace scn {
         }
 
     private:
-        friend class iterator;
+        friend iterator;
 
         expected<CharT> _read_single() const;
 
-        void _sync_all() noexcept
+        void _set_rollback_point(std::size_t pos) const noexcept
         {
-            _sync_until(m_buffer.size());
+            m_consumed = pos;
+            if (m_windowed) {
+                _discard_consumed();
+            }
+        }
+
+        bool _sync_all() noexcept
+        {
+            return _sync_until(m_consumed);
+        }
+        bool _sync_until(size_t pos) noexcept;
+
+        // Drop consumed characters from the beginning of the buffer.
+        // Only done in batches, to avoid moving the rest of the buffer
+        // every time a rollback point is set.
+        void _discard_consumed() const
+        {
+            SCN_EXPECT(m_consumed >= m_buffer_offset);
+            const auto n = m_consumed - m_buffer_offset;
+            if (n < detail::file_window_discard_threshold) {
+                return;
+            }
+            m_buffer.erase(0, n);
+            m_buffer_offset = m_consumed;
         }
-        void _sync_until(size_t pos) noexcept;
 
         CharT _get_char_at(size_t i) const
         {
             SCN_EXPECT(valid());
-            SCN_EXPECT(i < m_buffer.size());
-            return m_buffer[i];
+            SCN_EXPECT(i >= m_buffer_offset);
+            SCN_EXPECT(i - m_buffer_offset < m_buffer.size());
+            return m_buffer[i - m_buffer_offset];
         }
 
         bool _is_at_end(size_t i) const
         {
             SCN_EXPECT(valid());
-            return i >= m_buffer.size();
+            return i >= m_buffer_offset + m_buffer.size();
         }
 
         mutable std::basic_string<CharT> m_buffer{};
         FILE* m_file{nullptr};
+        // Position of the last rollback point, everything before it has been
+        // consumed by scanning
+        mutable std::size_t m_consumed{0};
+        // Position of m_buffer[0] in the file, non-zero if consumed
+        // characters have been dropped from the buffer when windowed
+        mutable std::size_t m_buffer_offset{0};
+        mutable detail::file_read_mode m_read_mode{
+            detail::file_read_mode::unknown};
+        bool m_windowed{false};
+        // wfile only: read as UTF-8 bytes, see set_utf8()
+        bool m_utf8{false};
+        // wfile only: the beginning of a UTF-8 sequence cut off at the end
+        // of the last block read
+        mutable char m_carry[4]{};
+        mutable std::size_t m_carry_size{0};
     };
 
     using file = basic_file<char>;
     using wfile = basic_file<wchar_t>;
 
-    template <>
-    expected<char> file::iterator::operator*() const;
-    template <>
-    expected<wchar_t> wfile::iterator::operator*() const;
-    template <>
-    bool file::iterator::operator==(const file::iterator&) const;
-    template <>
-    bool wfile::iterator::operator==(const wfile::iterator&) const;
-
     template <>
     expected<char> file::_read_single() const;
     template <>
     expected<wchar_t> wfile::_read_single() const;
     template <>
-    void file::_sync_until(size_t) noexcept;
+    bool file::_sync_until(size_t) noexcept;
     template <>
-    void wfile::_sync_until(size_t) noexcept;
+    bool wfile::_sync_until(size_t) noexcept;
 
     /**
      * A child class for basic_file, handling fopen, fclose, and lifetimes with
@@ -477,7 +763,12 @@ namespace scn {
             }
         }
 
-        /// fopen
+        /**
+         * fopen, and set the orientation of the stream to match `CharT`.
+         * A `wfile` declared with set_utf8() before opening is left
+         * unoriented, like when constructed from a file name,
+         * so that it can be read in blocks.
+         */
         bool open(const char* f, const char* mode)
         {
             SCN_EXPECT(!is_open());
@@ -488,6 +779,10 @@ namespace scn {
             }
 
             const bool is_wide = sizeof(CharT) > 1;
+            if (is_wide && this->utf8()) {
+                this->set_handle(h);
+                return true;
+            }
             auto ret = std::fwide(h, is_wide ? 1 : -1);
             if ((is_wide && ret > 0) || (!is_wide && ret < 0) || ret == 0) {
                 this->set_handle(h);
@@ -525,6 +820,1092 @@ namespace scn {
     using owning_file = basic_owning_file<char>;
     using owning_wfile = basic_owning_file<wchar_t>;
 
+    namespace detail {
+        /**
+         * Read at most `size` bytes from `h` into `buf`.
+         * Returns the number of bytes read, `0` on EOF,
+         * or `-1` on error.
+         */
+        std::ptrdiff_t read_native(native_file_handle h,
+                                   void* buf,
+                                   std::size_t size) noexcept;
+        /// Move the file position of `h` back by `n` bytes, if it's seekable
+        bool seek_back_native(native_file_handle h, std::size_t n) noexcept;
+    }  // namespace detail
+
+    /**
+     * Range reading directly from a native file handle
+     * (a file descriptor on POSIX, a HANDLE on Windows),
+     * bypassing <cstdio>.
+     *
+     * Reads in blocks of `detail::file_block_size` characters into its own
+     * buffer, with a single system call each, so that pipes and sockets don't
+     * get double-buffered or locked by stdio.
+     * The buffer is accessible through get_buffer(), so contiguous algorithms
+     * can be used on each block.
+     *
+     * Doesn't own the handle, see basic_owning_fd_file.
+     * Not copyable or reconstructible.
+     */
+    template <typename CharT>
+    class basic_fd_file {
+        friend struct detail::basic_file_iterator_access<basic_fd_file>;
+
+    public:
+        using iterator = detail::basic_file_iterator<CharT, basic_fd_file>;
+        using sentinel = iterator;
+        using char_type = CharT;
+        using handle_type = detail::native_file_handle::handle_type;
+
+        /**
+         * Construct an empty file.
+         * Reading not possible: valid() is `false`
+         */
+        basic_fd_file() = default;
+        /**
+         * Construct from a native file handle.
+         * Must be a valid handle that can be read from.
+         */
+        explicit basic_fd_file(handle_type h) : m_handle{h} {}
+
+        basic_fd_file(const basic_fd_file&) = delete;
+        basic_fd_file& operator=(const basic_fd_file&) = delete;
+
+        basic_fd_file(basic_fd_file&& o) noexcept
+            : m_buffer(detail::exchange(o.m_buffer, {})),
+              m_handle(detail::exchange(o.m_handle,
+                                        detail::native_file_handle::invalid())),
+              m_consumed(detail::exchange(o.m_consumed, std::size_t{0})),
+              m_buffer_offset(
+                  detail::exchange(o.m_buffer_offset, std::size_t{0})),
+              m_windowed(detail::exchange(o.m_windowed, false))
+        {
+        }
+        basic_fd_file& operator=(basic_fd_file&& o) noexcept
+        {
+            if (valid()) {
+                sync();
+            }
+            m_buffer = detail::exchange(o.m_buffer, {});
+            m_handle = detail::exchange(o.m_handle,
+                                        detail::native_file_handle::invalid());
+            m_consumed = detail::exchange(o.m_consumed, std::size_t{0});
+            m_buffer_offset =
+                detail::exchange(o.m_buffer_offset, std::size_t{0});
+            m_windowed = detail::exchange(o.m_windowed, false);
+            return *this;
+        }
+
+        ~basic_fd_file()
+        {
+            if (valid()) {
+                _sync_all();
+            }
+        }
+
+        /**
+         * Get the native handle for this range.
+         * Only use this handle for reading sync() has been called and no
+         * reading operations have taken place after that.
+         *
+         * \see sync
+         */
+        handle_type handle() const
+        {
+            return m_handle.handle;
+        }
+
+        /**
+         * Reset the native handle.
+         * Calls sync(), if necessary, before resetting.
+         * @return The old handle
+         */
+        handle_type set_handle(handle_type h, bool allow_sync = true) noexcept
+        {
+            auto old = m_handle.handle;
+            if (valid() && allow_sync) {
+                sync();
+            }
+            m_handle.handle = h;
+            return old;
+        }
+
+        /// Whether the file has been opened
+        bool valid() const noexcept
+        {
+            return m_handle.handle !=
+                   detail::native_file_handle::invalid().handle;
+        }
+
+        /**
+         * Enable or disable windowed buffering.
+         *
+         * \see basic_file::set_windowed()
+         */
+        void set_windowed(bool windowed = true) noexcept
+        {
+            m_windowed = windowed;
+        }
+        /// Whether windowed buffering is enabled
+        SCN_NODISCARD bool windowed() const noexcept
+        {
+            return m_windowed;
+        }
+
+        /// Number of characters the buffer can hold without reallocating
+        SCN_NODISCARD std::size_t buffer_capacity() const noexcept
+        {
+            return m_buffer.capacity();
+        }
+
+        /**
+         * Synchronizes this file with the underlying handle.
+         * Invalidates all non-end iterators.
+         * File must be open.
+         *
+         * Characters read, but not consumed by a successful scanning
+         * operation, are given back by seeking the handle backwards.
+         * That's only possible if the handle is seekable:
+         * for pipes and sockets, they're dropped.
+         */
+        void sync() noexcept
+        {
+            _sync_all();
+            m_buffer.clear();
+            m_consumed = 0;
+            m_buffer_offset = 0;
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, m_buffer_offset};
+        }
+        sentinel end() const noexcept
+        {
+            return {};
+        }
+
+        span<const CharT> get_buffer(iterator it,
+                                     size_t max_size) const noexcept
+        {
+            if (!it.m_file) {
+                return {};
+            }
+            SCN_EXPECT(it.m_current >= m_buffer_offset);
+            const auto begin =
+                m_buffer.begin() +
+                static_cast<std::ptrdiff_t>(it.m_current - m_buffer_offset);
+            const auto end_diff = detail::min(
+                max_size,
+                static_cast<size_t>(ranges::distance(begin, m_buffer.end())));
+            return {begin, begin + static_cast<std::ptrdiff_t>(end_diff)};
+        }
+
+    private:
+        friend iterator;
+
+        expected<CharT> _read_single() const;
+
+        void _set_rollback_point(std::size_t pos) const noexcept
+        {
+            m_consumed = pos;
+            if (m_windowed) {
+                _discard_consumed();
+            }
+        }
+
+        void _sync_all() noexcept
+        {
+            SCN_EXPECT(m_consumed >= m_buffer_offset);
+            const auto n = m_buffer.size() - (m_consumed - m_buffer_offset);
+            if (n != 0) {
+                detail::seek_back_native(m_handle, n * sizeof(CharT));
+            }
+        }
+
+        void _discard_consumed() const
+        {
+            SCN_EXPECT(m_consumed >= m_buffer_offset);
+            const auto n = m_consumed - m_buffer_offset;
+            if (n < detail::file_window_discard_threshold) {
+                return;
+            }
+            m_buffer.erase(0, n);
+            m_buffer_offset = m_consumed;
+        }
+
+        CharT _get_char_at(size_t i) const
+        {
+            SCN_EXPECT(valid());
+            SCN_EXPECT(i >= m_buffer_offset);
+            SCN_EXPECT(i - m_buffer_offset < m_buffer.size());
+            return m_buffer[i - m_buffer_offset];
+        }
+
+        bool _is_at_end(size_t i) const
+        {
+            SCN_EXPECT(valid());
+            return i >= m_buffer_offset + m_buffer.size();
+        }
+
+        mutable std::basic_string<CharT> m_buffer{};
+        detail::native_file_handle m_handle{
+            detail::native_file_handle::invalid().handle};
+        mutable std::size_t m_consumed{0};
+        mutable std::size_t m_buffer_offset{0};
+        bool m_windowed{false};
+    };
+
+    using fd_file = basic_fd_file<char>;
+    using wfd_file = basic_fd_file<wchar_t>;
+
+    template <>
+    expected<char> fd_file::_read_single() const;
+    template <>
+    expected<wchar_t> wfd_file::_read_single() const;
+
+    namespace detail {
+        native_file_handle open_native(const char* filename) noexcept;
+        void close_native(native_file_handle h) noexcept;
+    }  // namespace detail
+
+    /**
+     * A child class for basic_fd_file, opening and closing the native handle
+     * with RAII.
+     */
+    template <typename CharT>
+    class basic_owning_fd_file : public basic_fd_file<CharT> {
+    public:
+        using char_type = CharT;
+        using handle_type = typename basic_fd_file<CharT>::handle_type;
+
+        /// Open an empty file
+        basic_owning_fd_file() = default;
+        /// Open a file for reading
+        explicit basic_owning_fd_file(const char* f)
+            : basic_fd_file<CharT>(detail::open_native(f).handle)
+        {
+        }
+
+        /// Steal ownership of a native handle
+        explicit basic_owning_fd_file(handle_type h) : basic_fd_file<CharT>(h)
+        {
+        }
+
+        basic_owning_fd_file(basic_owning_fd_file&&) noexcept = default;
+        basic_owning_fd_file& operator=(basic_owning_fd_file&& o) noexcept
+        {
+            if (is_open()) {
+                close();
+            }
+            basic_fd_file<CharT>::operator=(SCN_MOVE(o));
+            return *this;
+        }
+
+        ~basic_owning_fd_file()
+        {
+            if (is_open()) {
+                close();
+            }
+        }
+
+        /// Open a file for reading
+        bool open(const char* f)
+        {
+            SCN_EXPECT(!is_open());
+
+            auto h = detail::open_native(f);
+            if (h.handle == detail::native_file_handle::invalid().handle) {
+                return false;
+            }
+            this->set_handle(h.handle);
+            return true;
+        }
+        /// Steal ownership
+        void open(handle_type h)
+        {
+            SCN_EXPECT(!is_open());
+            this->set_handle(h);
+        }
+
+        /// Close file
+        void close()
+        {
+            SCN_EXPECT(is_open());
+            this->sync();
+            detail::close_native({this->handle()});
+            this->set_handle(detail::native_file_handle::invalid().handle,
+                             false);
+        }
+
+        /// Is the file open
+        SCN_NODISCARD bool is_open() const
+        {
+            return this->valid();
+        }
+    };
+
+    using owning_fd_file = basic_owning_fd_file<char>;
+    using owning_wfd_file = basic_owning_fd_file<wchar_t>;
+
+    namespace detail {
+        /// Default size of a window of a basic_windowed_mapped_file
+        static constexpr std::size_t mapped_file_window_size = 16u << 20u;
+
+        /**
+         * A file, of which only a single window is mapped into memory at a
+         * time.
+         * Offsets and sizes are in bytes.
+         */
+        class byte_windowed_mapped_file {
+        public:
+            byte_windowed_mapped_file() = default;
+            byte_windowed_mapped_file(const char* filename,
+                                      std::size_t window_size);
+
+            byte_windowed_mapped_file(const byte_windowed_mapped_file&) =
+                delete;
+            byte_windowed_mapped_file& operator=(
+                const byte_windowed_mapped_file&) = delete;
+
+            byte_windowed_mapped_file(byte_windowed_mapped_file&& o) noexcept
+                : m_map(exchange(o.m_map, span<char>{})),
+                  m_map_offset(exchange(o.m_map_offset, std::uint64_t{0})),
+                  m_file_size(exchange(o.m_file_size, std::uint64_t{0})),
+                  m_window_size(exchange(o.m_window_size, std::size_t{0})),
+                  m_granularity(exchange(o.m_granularity, std::size_t{0})),
+                  m_file(exchange(o.m_file, native_file_handle::invalid()))
+            {
+#if SCN_WINDOWS
+                m_map_handle =
+                    exchange(o.m_map_handle, native_file_handle::invalid());
+#endif
+            }
+            byte_windowed_mapped_file& operator=(
+                byte_windowed_mapped_file&& o) noexcept
+            {
+                if (valid()) {
+                    _destruct();
+                }
+
+                m_map = exchange(o.m_map, span<char>{});
+                m_map_offset = exchange(o.m_map_offset, std::uint64_t{0});
+                m_file_size = exchange(o.m_file_size, std::uint64_t{0});
+                m_window_size = exchange(o.m_window_size, std::size_t{0});
+                m_granularity = exchange(o.m_granularity, std::size_t{0});
+                m_file = exchange(o.m_file, native_file_handle::invalid());
+#if SCN_WINDOWS
+                m_map_handle =
+                    exchange(o.m_map_handle, native_file_handle::invalid());
+#endif
+                return *this;
+            }
+
+            ~byte_windowed_mapped_file()
+            {
+                if (valid()) {
+                    _destruct();
+                }
+            }
+
+            SCN_NODISCARD bool valid() const
+            {
+                return m_file.handle != native_file_handle::invalid().handle;
+            }
+
+            /// Size of the entire file
+            SCN_NODISCARD std::uint64_t file_size() const noexcept
+            {
+                return m_file_size;
+            }
+            /// Size of a window, a multiple of the mapping granularity
+            SCN_NODISCARD std::size_t window_size() const noexcept
+            {
+                return m_window_size;
+            }
+
+        protected:
+            /**
+             * Replace the current window with one containing
+             * `[begin, end)`, starting from the closest properly aligned
+             * offset before `begin`.
+             * The window is larger than `window_size()` only if
+             * `[begin, end)` doesn't fit into one otherwise.
+             */
+            bool _map_window(std::uint64_t begin, std::uint64_t end) const;
+            void _unmap_window() const;
+            void _destruct();
+
+            mutable span<char> m_map{};
+            mutable std::uint64_t m_map_offset{0};
+            std::uint64_t m_file_size{0};
+            std::size_t m_window_size{0};
+            std::size_t m_granularity{0};
+            native_file_handle m_file{native_file_handle::invalid().handle};
+#if SCN_WINDOWS
+            native_file_handle m_map_handle{
+                native_file_handle::invalid().handle};
+#endif
+        };
+    }  // namespace detail
+
+    /**
+     * Memory-mapped file range, mapping a fixed-size window of the file at a
+     * time.
+     *
+     * The window slides forward as the range is read,
+     * so memory use depends only on the window size, not on the size of the
+     * file. This also makes it possible to scan files larger than the
+     * address space.
+     *
+     * When sliding, everything from the last rollback point onwards stays
+     * mapped, so that a value being scanned is never split between two
+     * windows, and can be accessed as a single span with get_buffer().
+     * Iterators pointing to before the current window are invalidated.
+     */
+    template <typename CharT>
+    class basic_windowed_mapped_file
+        : public detail::byte_windowed_mapped_file {
+        friend struct detail::basic_file_iterator_access<
+            basic_windowed_mapped_file>;
+
+    public:
+        using iterator = detail::basic_file_iterator<CharT,
+                                                     basic_windowed_mapped_file,
+                                                     std::uint64_t>;
+        using sentinel = iterator;
+        using char_type = CharT;
+
+        /// Constructs an empty mapping
+        basic_windowed_mapped_file() = default;
+
+        /**
+         * Opens a file, with windows of `window_size` bytes.
+         * The window size is rounded up to the mapping granularity of the
+         * platform.
+         */
+        explicit basic_windowed_mapped_file(
+            const char* f,
+            std::size_t window_size = detail::mapped_file_window_size)
+            : detail::byte_windowed_mapped_file{f, window_size}
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, m_buffer_offset};
+        }
+        sentinel end() const noexcept
+        {
+            return {};
+        }
+
+        /// Number of characters in the file
+        SCN_NODISCARD std::uint64_t size() const noexcept
+        {
+            return file_size() / sizeof(CharT);
+        }
+
+        span<const CharT> get_buffer(iterator it,
+                                     size_t max_size) const noexcept
+        {
+            if (!it.m_file) {
+                return {};
+            }
+            SCN_EXPECT(it.m_current >= m_buffer_offset);
+            SCN_EXPECT(it.m_current - m_buffer_offset <= m_buffer.size());
+            const auto begin =
+                m_buffer.begin() +
+                static_cast<std::ptrdiff_t>(it.m_current - m_buffer_offset);
+            const auto end_diff = detail::min(
+                max_size,
+                static_cast<size_t>(ranges::distance(begin, m_buffer.end())));
+            return {begin, begin + static_cast<std::ptrdiff_t>(end_diff)};
+        }
+
+    private:
+        friend iterator;
+
+        // Slides the window forward past its current end
+        expected<CharT> _read_single() const
+        {
+            const auto end = m_buffer_offset + m_buffer.size();
+            if (end >= size()) {
+                return error(error::end_of_range, "EOF");
+            }
+
+            const auto keep_from = detail::min(m_consumed, end);
+            if (!_map_window(keep_from * sizeof(CharT),
+                             (end + 1) * sizeof(CharT))) {
+                m_buffer = {};
+                m_buffer_offset = end;
+                return error(error::source_error, "Failed to map file");
+            }
+            m_buffer_offset = m_map_offset / sizeof(CharT);
+            m_buffer = span<const CharT>{
+                reinterpret_cast<const CharT*>(m_map.data()),
+                m_map.size() / sizeof(CharT)};
+            return _get_char_at(end);
+        }
+
+        void _set_rollback_point(std::uint64_t pos) const noexcept
+        {
+            m_consumed = pos;
+        }
+
+        CharT _get_char_at(std::uint64_t i) const
+        {
+            SCN_EXPECT(valid());
+            SCN_EXPECT(i >= m_buffer_offset);
+            SCN_EXPECT(i - m_buffer_offset < m_buffer.size());
+            return m_buffer[static_cast<std::size_t>(i - m_buffer_offset)];
+        }
+
+        bool _is_at_end(std::uint64_t i) const
+        {
+            SCN_EXPECT(valid());
+            return i >= m_buffer_offset + m_buffer.size();
+        }
+
+        // The current window
+        mutable span<const CharT> m_buffer{};
+        // Position of m_buffer[0] in the file
+        mutable std::uint64_t m_buffer_offset{0};
+        // Position of the last rollback point
+        mutable std::uint64_t m_consumed{0};
+    };
+
+    using windowed_mapped_file = basic_windowed_mapped_file<char>;
+    using windowed_mapped_wfile = basic_windowed_mapped_file<wchar_t>;
+
+    namespace detail {
+        /// Number of bytes transcoded at once by a transcoding_mapped_wfile
+        static constexpr std::size_t mapped_transcode_chunk_size =
+            16 * file_block_size;
+    }  // namespace detail
+
+    /**
+     * Memory-mapped UTF-8 file, read as wide characters.
+     *
+     * Unlike mapped_wfile, which reinterprets the bytes of the file as
+     * `wchar_t`, the mapping is decoded from UTF-8 to UTF-16 or UTF-32
+     * (depending on the size of `wchar_t`), one chunk at a time,
+     * as the range is read.
+     *
+     * The decoded characters are kept in a buffer,
+     * accessible through get_buffer(). Consumed characters are dropped from
+     * it, like with basic_file::set_windowed(),
+     * so the whole file is never decoded at once.
+     */
+    class transcoding_mapped_wfile : public detail::byte_mapped_file {
+        friend struct detail::basic_file_iterator_access<
+            transcoding_mapped_wfile>;
+
+    public:
+        using iterator =
+            detail::basic_file_iterator<wchar_t, transcoding_mapped_wfile>;
+        using sentinel = iterator;
+        using char_type = wchar_t;
+
+        /// Constructs an empty mapping
+        transcoding_mapped_wfile() = default;
+
+        /// Constructs a mapping to a filename
+        explicit transcoding_mapped_wfile(const char* f)
+            : detail::byte_mapped_file{f}
+        {
+        }
+        /// Constructs a mapping to a filename, with access hints
+        transcoding_mapped_wfile(const char* f,
+                                 const mapped_file_options& opt)
+            : detail::byte_mapped_file{f, opt}
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return {*this, m_buffer_offset};
+        }
+        sentinel end() const noexcept
+        {
+            return {};
+        }
+
+        span<const wchar_t> get_buffer(iterator it,
+                                       size_t max_size) const noexcept
+        {
+            if (!it.m_file) {
+                return {};
+            }
+            SCN_EXPECT(it.m_current >= m_buffer_offset);
+            const auto begin =
+                m_buffer.begin() +
+                static_cast<std::ptrdiff_t>(it.m_current - m_buffer_offset);
+            const auto end_diff = detail::min(
+                max_size,
+                static_cast<size_t>(ranges::distance(begin, m_buffer.end())));
+            return {begin, begin + static_cast<std::ptrdiff_t>(end_diff)};
+        }
+
+    private:
+        friend iterator;
+
+        // Decode the next chunk of the mapping into the buffer
+        expected<wchar_t> _read_single() const;
+
+        void _set_rollback_point(std::size_t pos) const noexcept;
+
+        wchar_t _get_char_at(size_t i) const
+        {
+            SCN_EXPECT(valid());
+            SCN_EXPECT(i >= m_buffer_offset);
+            SCN_EXPECT(i - m_buffer_offset < m_buffer.size());
+            return m_buffer[i - m_buffer_offset];
+        }
+
+        bool _is_at_end(size_t i) const
+        {
+            SCN_EXPECT(valid());
+            return i >= m_buffer_offset + m_buffer.size();
+        }
+
+        mutable std::wstring m_buffer{};
+        // Position of m_buffer[0] in the decoded file
+        mutable std::size_t m_buffer_offset{0};
+        // The byte m_buffer[0] was decoded from
+        mutable const char* m_buffer_input{m_map.data()};
+        // The first byte not yet decoded
+        mutable const char* m_input{m_map.data()};
+    };
+
+#if SCN_HAS_READAHEAD_FILE
+    namespace detail {
+        /// Size of a single read of a basic_readahead_file, in bytes
+        static constexpr std::size_t readahead_block_size = 64u << 10u;
+
+        struct readahead_state;
+
+        /**
+         * Reads a native file handle on a background thread,
+         * into two blocks: one is filled while the other one is used.
+         * The blocks are handed over between the threads under a mutex,
+         * and a thread waiting for a block sleeps on a condition variable.
+         *
+         * Only regular files are read:
+         * for other handles, valid() is `false`.
+         */
+        class byte_readahead_file {
+        public:
+            byte_readahead_file() = default;
+            byte_readahead_file(native_file_handle h, bool owns_handle);
+
+            byte_readahead_file(const byte_readahead_file&) = delete;
+            byte_readahead_file& operator=(const byte_readahead_file&) =
+                delete;
+
+            byte_readahead_file(byte_readahead_file&& o) noexcept
+                : m_state(exchange(o.m_state, nullptr))
+            {
+            }
+            byte_readahead_file& operator=(byte_readahead_file&& o) noexcept
+            {
+                if (valid()) {
+                    _destruct();
+                }
+                m_state = exchange(o.m_state, nullptr);
+                return *this;
+            }
+
+            ~byte_readahead_file()
+            {
+                if (valid()) {
+                    _destruct();
+                }
+            }
+
+            SCN_NODISCARD bool valid() const noexcept
+            {
+                return m_state != nullptr;
+            }
+
+        protected:
+            /**
+             * Wait for the next block to be read.
+             * Returns an empty span on EOF.
+             * The block stays valid until _release_block() is called.
+             */
+            expected<span<const char>> _acquire_block() const;
+            /// Give the last acquired block back to the reading thread
+            void _release_block() const noexcept;
+
+            void _destruct() noexcept;
+
+            readahead_state* m_state{nullptr};
+        };
+    }  // namespace detail
+#endif  // SCN_HAS_READAHEAD_FILE
+
+    namespace detail {
+        /**
+         * Range reading a file in blocks from `Source`, which provides
+         * them with `_acquire_block()` and `_release_block()`.
+         *
+         * The block being scanned is held until the scan moves past its
+         * end, and get_buffer() points directly into it: nothing is copied.
+         * Only the characters after the rollback point, that is, a value
+         * split between two blocks, are copied into a separate buffer
+         * before the block is given back.
+         * Consumed characters aren't accessible afterwards,
+         * like with basic_file::set_windowed().
+         *
+         * A wide character split between two blocks is put together in
+         * that buffer, and so is the rest of its block, if it's not
+         * suitably aligned for `CharT`.
+         *
+         * Characters read ahead can't be given back to the file:
+         * the file can't be used by anything else while this range exists.
+         */
+        template <typename CharT, typename Source>
+        class basic_block_source_file : public Source {
+            friend struct basic_file_iterator_access<basic_block_source_file>;
+
+        public:
+            using iterator =
+                basic_file_iterator<CharT, basic_block_source_file>;
+            using sentinel = iterator;
+            using char_type = CharT;
+            using handle_type = native_file_handle::handle_type;
+
+            /// Construct an empty file
+            basic_block_source_file() = default;
+            /// Open a file for reading, closed on destruction
+            template <typename... Args>
+            explicit basic_block_source_file(const char* filename,
+                                             Args&&... args)
+                : basic_block_source_file(open_native(filename),
+                                          true,
+                                          SCN_FWD(args)...)
+            {
+            }
+            /// Read from a native handle, which is not closed on destruction
+            template <typename... Args>
+            explicit basic_block_source_file(handle_type h, Args&&... args)
+                : basic_block_source_file(native_file_handle{h},
+                                          false,
+                                          SCN_FWD(args)...)
+            {
+            }
+
+            iterator begin() const noexcept
+            {
+                return {*this, m_carry_offset};
+            }
+            sentinel end() const noexcept
+            {
+                return {};
+            }
+
+            /**
+             * Characters available from `it`, at most `max_size`:
+             * either the rest of the copied characters, or the rest of the
+             * current block.
+             */
+            span<const CharT> get_buffer(iterator it,
+                                         size_t max_size) const noexcept
+            {
+                if (!it.m_file) {
+                    return {};
+                }
+                SCN_EXPECT(it.m_current >= m_carry_offset);
+                const CharT* begin{};
+                std::size_t size{};
+                if (it.m_current < m_block_offset) {
+                    begin = m_carry.data() + (it.m_current - m_carry_offset);
+                    size = m_block_offset - it.m_current;
+                }
+                else {
+                    const auto n = detail::min(it.m_current - m_block_offset,
+                                               m_block.size());
+                    begin = m_block.data() + n;
+                    size = m_block.size() - n;
+                }
+                return {begin, begin + detail::min(max_size, size)};
+            }
+
+        private:
+            friend iterator;
+
+            template <typename... Args>
+            basic_block_source_file(native_file_handle h,
+                                    bool owns,
+                                    Args&&... args)
+                : Source(h.handle == native_file_handle::invalid().handle
+                             ? Source{}
+                             : Source{h, owns, SCN_FWD(args)...})
+            {
+            }
+
+            expected<CharT> _read_single() const
+            {
+                SCN_EXPECT(this->valid());
+                const auto pos = m_block_offset + m_block.size();
+                _give_back_block();
+                while (m_block_offset == pos && m_block.size() == 0) {
+                    auto block = this->_acquire_block();
+                    if (!block) {
+                        return block.error();
+                    }
+                    if (block.value().size() == 0) {
+                        if (m_partial_size != 0) {
+                            return error(
+                                error::invalid_encoding,
+                                "Incomplete character at end of file");
+                        }
+                        return error(error::end_of_range, "EOF");
+                    }
+                    m_holding_block = true;
+                    _take_block(block.value());
+                }
+                return _get_char_at(pos);
+            }
+
+            // Keep the characters after the rollback point,
+            // and let the source reuse the block
+            void _give_back_block() const
+            {
+                const auto end = m_block_offset + m_block.size();
+                if (m_consumed > m_carry_offset) {
+                    m_carry.erase(0, detail::min(m_consumed - m_carry_offset,
+                                                 m_carry.size()));
+                }
+                const auto keep_from = detail::max(m_consumed, m_block_offset);
+                if (keep_from < end) {
+                    m_carry.append(
+                        m_block.data() + (keep_from - m_block_offset),
+                        end - keep_from);
+                }
+                m_carry_offset = end - m_carry.size();
+                m_block = {};
+                m_block_offset = end;
+                if (m_holding_block) {
+                    this->_release_block();
+                    m_holding_block = false;
+                }
+            }
+
+            void _take_block(span<const char> block) const
+            {
+                auto data = block.data();
+                auto n = block.size();
+                if (m_partial_size != 0) {
+                    const auto k =
+                        detail::min(sizeof(CharT) - m_partial_size, n);
+                    std::memcpy(m_partial + m_partial_size, data, k);
+                    m_partial_size += k;
+                    data += k;
+                    n -= k;
+                    if (m_partial_size == sizeof(CharT)) {
+                        CharT ch{};
+                        std::memcpy(&ch, m_partial, sizeof(CharT));
+                        m_carry.push_back(ch);
+                        ++m_block_offset;
+                        m_partial_size = 0;
+                    }
+                }
+
+                const auto count = n / sizeof(CharT);
+                const bool aligned =
+                    reinterpret_cast<std::uintptr_t>(data) % alignof(CharT) ==
+                    0;
+                if (count != 0 && aligned) {
+                    m_block = {reinterpret_cast<const CharT*>(data), count};
+                }
+                else if (count != 0) {
+                    const auto prev_size = m_carry.size();
+                    m_carry.resize(prev_size + count);
+                    std::memcpy(&m_carry[prev_size], data,
+                                count * sizeof(CharT));
+                    m_block_offset += count;
+                }
+
+                m_partial_size = n - count * sizeof(CharT);
+                std::memcpy(m_partial, data + count * sizeof(CharT),
+                            m_partial_size);
+
+                if (m_block.size() == 0) {
+                    // Everything needed was copied
+                    this->_release_block();
+                    m_holding_block = false;
+                }
+            }
+
+            void _set_rollback_point(std::size_t pos) const noexcept
+            {
+                SCN_EXPECT(pos >= m_carry_offset);
+                m_consumed = pos;
+                if (pos >= m_block_offset && !m_carry.empty()) {
+                    m_carry.clear();
+                    m_carry_offset = m_block_offset;
+                }
+            }
+
+            CharT _get_char_at(size_t i) const
+            {
+                SCN_EXPECT(this->valid());
+                SCN_EXPECT(i >= m_carry_offset);
+                if (i < m_block_offset) {
+                    return m_carry[i - m_carry_offset];
+                }
+                SCN_EXPECT(i - m_block_offset < m_block.size());
+                return m_block[i - m_block_offset];
+            }
+
+            bool _is_at_end(size_t i) const
+            {
+                SCN_EXPECT(this->valid());
+                return i >= m_block_offset + m_block.size();
+            }
+
+            // Characters copied out of earlier blocks,
+            // from m_carry_offset up to m_block_offset
+            mutable std::basic_string<CharT> m_carry{};
+            mutable std::size_t m_carry_offset{0};
+            // The held block, starting at m_block_offset
+            mutable span<const CharT> m_block{};
+            mutable std::size_t m_block_offset{0};
+            mutable std::size_t m_consumed{0};
+            mutable char m_partial[sizeof(CharT)]{};
+            mutable std::size_t m_partial_size{0};
+            mutable bool m_holding_block{false};
+        };
+    }  // namespace detail
+
+#if SCN_HAS_READAHEAD_FILE
+    /**
+     * Range reading a file in the background:
+     * while the calling thread scans one block of the file,
+     * another thread reads the next one with read() (ReadFile on Windows).
+     * This hides I/O latency on slow storage, like spinning disks and
+     * network filesystems.
+     *
+     * Only regular files can be read: a read from a pipe or a socket might
+     * never return, and the reading thread is joined on destruction.
+     * For other files, valid() is `false`.
+     * Destruction waits for a read already in progress to complete.
+     *
+     * Constructible from a file name, or a native handle,
+     * which is not closed on destruction.
+     * See detail::basic_block_source_file for details.
+     */
+    template <typename CharT>
+    using basic_readahead_file =
+        detail::basic_block_source_file<CharT, detail::byte_readahead_file>;
+
+    using readahead_file = basic_readahead_file<char>;
+    using readahead_wfile = basic_readahead_file<wchar_t>;
+#endif  // SCN_HAS_READAHEAD_FILE
+
+    /**
+     * Options for basic_uring_file
+     */
+    struct uring_file_options {
+        /// Number of reads kept in flight at once
+        std::size_t queue_depth{4};
+        /// Size of a single read, in bytes
+        std::size_t block_size{256u << 10u};
+        /// Always use the pread() fallback
+        bool disable_io_uring{false};
+    };
+
+    namespace detail {
+        struct uring_state;
+
+        /**
+         * Reads a native file handle with io_uring, keeping
+         * `queue_depth` reads of consecutive blocks in flight.
+         * The blocks are registered with the kernel, if possible.
+         *
+         * Without io_uring, or if setting it up fails at runtime,
+         * the file is read one block at a time with pread().
+         */
+        class byte_uring_file {
+        public:
+            byte_uring_file() = default;
+            byte_uring_file(native_file_handle h,
+                            bool owns_handle,
+                            uring_file_options opt = {});
+
+            byte_uring_file(const byte_uring_file&) = delete;
+            byte_uring_file& operator=(const byte_uring_file&) = delete;
+
+            byte_uring_file(byte_uring_file&& o) noexcept
+                : m_state(exchange(o.m_state, nullptr))
+            {
+            }
+            byte_uring_file& operator=(byte_uring_file&& o) noexcept
+            {
+                if (valid()) {
+                    _destruct();
+                }
+                m_state = exchange(o.m_state, nullptr);
+                return *this;
+            }
+
+            ~byte_uring_file()
+            {
+                if (valid()) {
+                    _destruct();
+                }
+            }
+
+            SCN_NODISCARD bool valid() const noexcept
+            {
+                return m_state != nullptr;
+            }
+
+            /// Whether reads are currently made through io_uring
+            SCN_NODISCARD bool uses_io_uring() const noexcept;
+
+        protected:
+            /**
+             * Wait for the next block to be read.
+             * Returns an empty span on EOF.
+             * The block stays valid until _release_block() is called.
+             */
+            expected<span<const char>> _acquire_block() const;
+            /// Queue a read into the last acquired block
+            void _release_block() const noexcept;
+
+            void _destruct() noexcept;
+
+            uring_state* m_state{nullptr};
+        };
+    }  // namespace detail
+
+    /**
+     * Range reading a file with io_uring on Linux,
+     * with several large reads in flight at once.
+     * Falls back to pread() if io_uring is not available at runtime.
+     *
+     * Values are scanned directly from the blocks the kernel reads into,
+     * which are registered buffers if possible:
+     * get_buffer() doesn't point to a copy.
+     * The block being scanned is read into again only after the scan has
+     * moved past it.
+     *
+     * The file needs to be seekable.
+     * Constructible from a file name, or a native handle,
+     * which is not closed on destruction, optionally followed by
+     * uring_file_options.
+     * See detail::basic_block_source_file for details.
+     */
+    template <typename CharT>
+    using basic_uring_file =
+        detail::basic_block_source_file<CharT, detail::byte_uring_file>;
+
+    using uring_file = basic_uring_file<char>;
+    using uring_wfile = basic_uring_file<wchar_t>;
+
     SCN_CLANG_PUSH
     SCN_CLANG_IGNORE("-Wexit-time-destructors")
 
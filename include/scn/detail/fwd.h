@@ -122,6 +122,10 @@ namespace scn {
     class basic_file;
     template <typename CharT>
     class basic_owning_file;
+    template <typename CharT>
+    class basic_fd_file;
+    template <typename CharT>
+    class basic_owning_fd_file;
 
     // scan.h
 
@@ -182,6 +186,12 @@ namespace scn {
         class unique_ptr;
     }
 
+#if SCN_HAS_INT128
+    // __extension__ keeps -pedantic quiet about the non-standard type
+    __extension__ typedef __int128 int128;
+    __extension__ typedef unsigned __int128 uint128;
+#endif
+
     // for SCN_MOVE
     namespace detail {
         template <typename T>
@@ -438,6 +438,12 @@ namespace scn {
                                               const string_type& buf,
                                               int base) const;
 
+            // std::numpunct::grouping() of the locale
+            string_view grouping() const;
+            // Whether the locale uses the ASCII digits and hex letters,
+            // allowing numbers to be parsed without the locale
+            bool has_ascii_digits() const;
+
         private:
             SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
             bool do_is_space(char_type ch) const override;
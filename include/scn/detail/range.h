@@ -59,6 +59,37 @@ namespace scn {
                 static_const<detail::_reset_begin_iterator::fn>::value;
         }
 
+        namespace _set_rollback_point {
+            struct fn {
+            private:
+                template <typename Iterator>
+                static auto impl(const Iterator& it, priority_tag<1>) noexcept(
+                    noexcept(it.set_rollback_point()))
+                    -> decltype(it.set_rollback_point())
+                {
+                    return it.set_rollback_point();
+                }
+
+                template <typename Iterator>
+                static void impl(const Iterator&, priority_tag<0>) noexcept
+                {
+                }
+
+            public:
+                template <typename Iterator>
+                auto operator()(const Iterator& it) const
+                    noexcept(noexcept(fn::impl(it, priority_tag<1>{})))
+                        -> decltype(fn::impl(it, priority_tag<1>{}))
+                {
+                    return fn::impl(it, priority_tag<1>{});
+                }
+            };
+        }  // namespace _set_rollback_point
+        namespace {
+            static constexpr auto& set_rollback_point =
+                static_const<detail::_set_rollback_point::fn>::value;
+        }
+
         template <typename Iterator, typename = void>
         struct extract_char_type;
         template <typename Iterator>
@@ -199,43 +230,30 @@ namespace scn {
             {
             }
 
-            range_wrapper(const range_wrapper& o) : m_range(o.m_range)
+            range_wrapper(const range_wrapper& o)
             {
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _assign_begin(o, o.m_range, is_stored_by_reference{});
                 m_read = o.m_read;
             }
             range_wrapper& operator=(const range_wrapper& o)
             {
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
-                m_range = o.m_range;
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _assign_begin(o, o.m_range, is_stored_by_reference{});
                 m_read = o.m_read;
                 return *this;
             }
 
             range_wrapper(range_wrapper&& o) noexcept
             {
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
-                m_range = SCN_MOVE(o.m_range);
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _assign_begin(o, SCN_MOVE(o.m_range),
+                              is_stored_by_reference{});
                 m_read = exchange(o.m_read, 0);
             }
             range_wrapper& operator=(range_wrapper&& o) noexcept
             {
                 reset_to_rollback_point();
 
-                const auto n =
-                    ranges::distance(o.begin_underlying(), o.m_begin);
-                m_range = SCN_MOVE(o.m_range);
-                m_begin = ranges::cbegin(m_range.get());
-                ranges::advance(m_begin, n);
+                _assign_begin(o, SCN_MOVE(o.m_range),
+                              is_stored_by_reference{});
                 m_read = exchange(o.m_read, 0);
                 return *this;
             }
@@ -320,7 +338,7 @@ namespace scn {
              * Note that `range_underlying().begin()` may not be equal to
              * `begin()`.
              */
-            const range_type& range_underlying() const noexcept
+            const range_nocvref_type& range_underlying() const noexcept
             {
                 return m_range.get();
             }
@@ -396,12 +414,15 @@ namespace scn {
             }
             /**
              * Sets the rollback point equal to the current `begin()` iterator.
+             * Notifies the iterator, if it has a member function
+             * `set_rollback_point()`.
              *
              * \see reset_to_rollback_point()
              */
             void set_rollback_point()
             {
                 m_read = 0;
+                detail::set_rollback_point(m_begin);
             }
 
             void reset_begin_iterator()
@@ -443,6 +464,35 @@ namespace scn {
                 provides_buffer_access_impl<range_nocvref_type>::value;
 
         private:
+            using is_stored_by_reference =
+                std::integral_constant<bool, std::is_reference<Range>::value>;
+
+            // Iterators into a range stored by reference stay valid when
+            // *this is copied or moved, and can be used as-is
+            template <typename Storage>
+            void _assign_begin(const range_wrapper& o,
+                               Storage&& storage,
+                               std::true_type)
+            {
+                m_range = SCN_FWD(storage);
+                m_begin = o.m_begin;
+            }
+            // Otherwise, begin needs to be reconstructed from
+            // the begin of the copied-to range.
+            // Distance has to be calculated before the assignment, in case
+            // the range is moved from.
+            template <typename Storage>
+            void _assign_begin(const range_wrapper& o,
+                               Storage&& storage,
+                               std::false_type)
+            {
+                const auto n =
+                    ranges::distance(o.begin_underlying(), o.m_begin);
+                m_range = SCN_FWD(storage);
+                m_begin = ranges::cbegin(m_range.get());
+                ranges::advance(m_begin, n);
+            }
+
             template <typename R = Range>
             bool _advance_check(std::ptrdiff_t n, std::true_type)
             {
@@ -69,11 +69,17 @@ namespace scn {
         SCN_VISIT_INT(int)
         SCN_VISIT_INT(long)
         SCN_VISIT_INT(long long)
+#if SCN_HAS_INT128
+        SCN_VISIT_INT(int128)
+#endif
         SCN_VISIT_INT(unsigned char)
         SCN_VISIT_INT(unsigned short)
         SCN_VISIT_INT(unsigned int)
         SCN_VISIT_INT(unsigned long)
         SCN_VISIT_INT(unsigned long long)
+#if SCN_HAS_INT128
+        SCN_VISIT_INT(uint128)
+#endif
         SCN_VISIT_INT(char_type)
 #undef SCN_VISIT_INT
 
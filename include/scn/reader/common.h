@@ -184,6 +184,12 @@ namespace scn {
                 return read_code_point_result<CharT>{sbuf.first(1),
                                                      make_code_point(sbuf[0])};
             }
+            if (sbuf.ssize() < len && sbuf.data() != writebuf.data()) {
+                // Code point continues past the end of the buffer:
+                // the rest of it is read into writebuf
+                std::copy(sbuf.begin(), sbuf.end(), writebuf.begin());
+                sbuf = writebuf.first(sbuf.size());
+            }
             while (sbuf.ssize() < len) {
                 auto ret = read_code_unit(r, true);
                 if (!ret) {
@@ -639,19 +645,16 @@ namespace scn {
                                      std::true_type)
         {
             if (!pred.is_multibyte()) {
-                while (r.begin() != r.end() && !done) {
-                    auto s = r.get_buffer_and_advance();
-                    for (auto it = s.begin(); it != s.end() && out_cmp(out);
-                         ++it) {
+                while (r.begin() != r.end() && !done && out_cmp(out)) {
+                    // Only advance past what's consumed from the buffer
+                    auto s = get_buffer(r.range_underlying(), r.begin());
+                    auto it = s.begin();
+                    for (; it != s.end() && out_cmp(out); ++it) {
                         if (pred(make_span(&*it, 1)) == pred_result_to_stop) {
                             if (keep_final) {
                                 *out = *it;
                                 ++out;
-                            }
-                            auto e =
-                                putback_n(r, ranges::distance(it, s.end()));
-                            if (!e) {
-                                return e;
+                                ++it;
                             }
                             done = true;
                             break;
@@ -659,6 +662,7 @@ namespace scn {
                         *out = *it;
                         ++out;
                     }
+                    r.advance(ranges::distance(s.begin(), it));
                     if (!done && out_cmp(out)) {
                         auto ret = read_code_unit(r, false);
                         if (!ret) {
@@ -684,19 +688,18 @@ namespace scn {
                 }
             }
             else {
-                while (r.begin() != r.end() && !done) {
-                    auto s = r.get_buffer_and_advance();
-                    for (auto it = s.begin(); it != s.end() && out_cmp(out);) {
+                while (r.begin() != r.end() && !done && out_cmp(out)) {
+                    auto s = get_buffer(r.range_underlying(), r.begin());
+                    auto it = s.begin();
+                    while (it != s.end() && out_cmp(out)) {
                         auto len = ::scn::get_sequence_length(*it);
                         if (len == 0) {
                             return error{error::invalid_encoding,
                                          "Invalid code point"};
                         }
                         if (ranges::distance(it, s.end()) < len) {
-                            auto e = putback_n(r, len);
-                            if (!e) {
-                                return e;
-                            }
+                            // Code point split between buffers:
+                            // read it below with read_code_point
                             break;
                         }
                         auto cpspan = make_span(it, static_cast<size_t>(len));
@@ -714,12 +717,15 @@ namespace scn {
                             if (keep_final) {
                                 out = std::copy(cpspan.begin(), cpspan.end(),
                                                 out);
+                                it += len;
                             }
                             done = true;
                             break;
                         }
                         out = std::copy(cpspan.begin(), cpspan.end(), out);
+                        it += len;
                     }
+                    r.advance(ranges::distance(s.begin(), it));
 
                     if (!done && out_cmp(out)) {
                         alignas(typename WrappedRange::char_type) unsigned char
@@ -166,6 +166,18 @@ namespace scn {
                     return {};
                 };
 
+                if (Context::range_type::is_contiguous && field_width != 0) {
+                    // Fixed-width field: take it whole, and put back
+                    // whatever the parser leaves over (e.g. padding),
+                    // instead of counting characters one at a time
+                    auto s = read_zero_copy(
+                        ctx.range(), static_cast<std::ptrdiff_t>(field_width));
+                    if (!s) {
+                        return s.error();
+                    }
+                    return do_parse_float(s.value());
+                }
+
                 auto is_space_pred = make_is_space_predicate(
                     ctx.locale(), (common_options & localized) != 0,
                     field_width);
@@ -206,10 +218,9 @@ namespace scn {
                                                  CharT locale_decimal_point)
             {
                 size_t chars{};
-                std::basic_string<CharT> str(s.data(), s.size());
                 SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                auto ret =
-                    _read_float_impl(str.data(), chars, locale_decimal_point);
+                auto ret = _read_float_impl(s.data(), s.size(), chars,
+                                            locale_decimal_point);
                 SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                 if (!ret) {
                     return ret.error();
@@ -220,6 +231,7 @@ namespace scn {
 
             template <typename CharT>
             expected<T> _read_float_impl(const CharT* str,
+                                         size_t len,
                                          size_t& chars,
                                          CharT locale_decimal_point);
         };
@@ -24,13 +24,48 @@
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
+    /**
+     * Options of an \ref integer_format.
+     * Each one has the effect of the corresponding format string flag.
+     */
+    enum integer_format_options : unsigned {
+        /// No sign allowed, like with 'u'
+        integer_format_unsigned = 4,
+        /// Accept a base prefix (`0b`, `0o`, `0x`), like with 'b', 'o' and 'x'
+        integer_format_prefix = 8
+    };
+
+    /**
+     * Integer format spec, fixed at compile time.
+     * Pass one in place of the format string to \ref scan, to have the
+     * base and options resolved into the scanner type, instead of parsing
+     * them from the format string for every argument.
+     *
+     * `Base` can be 2, 8, 10 or 16.
+     *
+     * \code{.cpp}
+     * int a, b;
+     * // Same as scn::scan(source, "{:x} {:x}", a, b);
+     * scn::scan(source,
+     *           scn::integer_format<16, scn::integer_format_prefix>{}, a, b);
+     * \endcode
+     */
+    template <unsigned Base, unsigned Options = 0>
+    struct integer_format {
+    };
+
     namespace detail {
+        template <typename T, unsigned Base, unsigned Options>
+        struct static_integer_scanner;
+
         template <typename T>
         struct integer_scanner : common_parser {
             static_assert(std::is_integral<T>::value,
                           "integer_scanner requires an integral type");
 
             friend struct simple_integer_scanner<T>;
+            template <typename, unsigned, unsigned>
+            friend struct static_integer_scanner;
 
             bool skip_preceding_whitespace()
             {
@@ -233,41 +268,93 @@ namespace scn {
                     expected<std::ptrdiff_t> ret{0};
                     if (SCN_UNLIKELY((format_options & localized_digits) !=
                                      0)) {
-                        SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-                        int b{base};
-                        auto r = parse_base_prefix<char_type>(s, b);
-                        if (!r) {
-                            return r.error();
-                        }
-                        if (b == -1) {
-                            // -1 means we read a '0'
-                            tmp = 0;
+                        const auto& loc = ctx.locale().get_localized();
+                        // Explicit bases are checked in parse().
+                        // A detected base is checked once the prefix has
+                        // been read, the same way whichever way the digits
+                        // are read, so that a format is accepted regardless
+                        // of the digits of the locale.
+                        const auto check_base = [&]() -> error {
+                            if (base != 0 && base != 8 && base != 10 &&
+                                base != 16) {
+                                return {error::invalid_scanned_value,
+                                        "Localized values have to be in "
+                                        "base 8, 10 or 16"};
+                            }
                             return {};
+                        };
+                        if (SCN_LIKELY(loc.has_ascii_digits())) {
+                            SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                            ret = _parse_int_grouped(
+                                tmp, s, loc.thousands_separator(),
+                                loc.grouping());
+                            SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+                            auto e = check_base();
+                            if (!e) {
+                                return e;
+                            }
                         }
-                        if (b != 10 && base != b && base != 0) {
-                            return {error::invalid_scanned_value,
-                                    "Invalid base prefix"};
-                        }
-                        if (base == 0) {
-                            base = static_cast<uint8_t>(b);
+                        else {
+                            SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                            int b{base};
+                            auto r = parse_base_prefix<char_type>(s, b);
+                            if (!r) {
+                                return r.error();
+                            }
+                            if (b == -1) {
+                                // -1 means we read a '0'
+                                tmp = 0;
+                                return {};
+                            }
+                            if (b != 10 && base != b && base != 0) {
+                                return {error::invalid_scanned_value,
+                                        "Invalid base prefix"};
+                            }
+                            if (base == 0) {
+                                base = static_cast<uint8_t>(b);
+                            }
+                            auto e = check_base();
+                            if (!e) {
+                                return e;
+                            }
+
+                            auto it = r.value();
+                            std::basic_string<char_type> str(
+                                to_address(it),
+                                static_cast<std::size_t>(s.end() - it));
+                            ret = _read_num_localized(
+                                loc, tmp, str, static_cast<int>(base),
+                                std::integral_constant<
+                                    bool, (sizeof(T) <= sizeof(long long))>{});
+                            if (ret) {
+                                ret = ret.value() +
+                                      ranges::distance(s.begin(), it);
+                            }
+
+                            if (tmp < T{0} &&
+                                (format_options & only_unsigned) != 0) {
+                                return {error::invalid_scanned_value,
+                                        "Parsed negative value when type "
+                                        "was 'u'"};
+                            }
+                            SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                         }
-                        if (base != 8 && base != 10 && base != 16) {
-                            return {error::invalid_scanned_value,
-                                    "Localized values have to be in base "
-                                    "8, 10 or 16"};
-                        }
-
-                        auto it = r.value();
-                        std::basic_string<char_type> str(to_address(it),
-                                                         s.size());
-                        ret = ctx.locale().get_localized().read_num(
-                            tmp, str, static_cast<int>(base));
-
-                        if (tmp < T{0} &&
-                            (format_options & only_unsigned) != 0) {
-                            return {error::invalid_scanned_value,
-                                    "Parsed negative value when type was 'u'"};
+                    }
+                    else if (SCN_UNLIKELY((format_options & allow_thsep) !=
+                                          0)) {
+                        const bool is_localized =
+                            (common_options & localized) != 0;
+                        auto thsep = ctx.locale()
+                                         .get(is_localized)
+                                         .thousands_separator();
+                        // Groups of three, unless the locale says otherwise
+                        auto grouping = string_view{"\3"};
+                        if (is_localized &&
+                            !ctx.locale().get_localized().grouping().empty()) {
+                            grouping = ctx.locale().get_localized().grouping();
                         }
+                        SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                        ret = _parse_int_grouped(tmp, s, thsep, grouping);
                         SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
                     }
                     else {
@@ -324,7 +411,8 @@ namespace scn {
                 }
                 SCN_MSVC_POP
 
-                std::basic_string<char_type> buf{};
+                // Only used if the source isn't contiguous
+                char_type buf[max_literal_length];
                 span<const char_type> bufspan{};
                 auto e = _read_source(
                     ctx, buf, bufspan,
@@ -369,63 +457,38 @@ namespace scn {
                 SCN_MSVC_POP
             }
 
-            template <typename Context, typename Buf, typename CharT>
+            // Longest accepted literal: binary digits of the largest
+            // magnitude with a sign and a base prefix, and room for as many
+            // thousands separators or leading zeroes.
+            // Non-contiguous sources are read into a buffer of this size.
+            static constexpr std::size_t max_literal_length =
+                2 * (static_cast<std::size_t>(std::numeric_limits<T>::digits) +
+                     1) +
+                3;
+
+            template <typename Context, typename CharT, std::size_t N>
             error _read_source(Context& ctx,
-                               Buf& buf,
+                               CharT (&buf)[N],
                                span<const CharT>& s,
                                std::false_type)
             {
-                auto do_read = [&](Buf& b) -> error {
-                    auto outputit = std::back_inserter(b);
-                    auto is_space_pred = make_is_space_predicate(
-                        ctx.locale(), (common_options & localized) != 0,
-                        field_width);
-                    auto e = read_until_space(ctx.range(), outputit,
-                                              is_space_pred, false);
-                    if (!e && b.empty()) {
-                        return e;
-                    }
-
-                    return {};
-                };
-
-                if (SCN_LIKELY((format_options & allow_thsep) == 0)) {
-                    auto e = do_read(buf);
-                    if (!e) {
-                        return e;
-                    }
-                    s = make_span(buf.data(), buf.size());
-                    return {};
-                }
-
-                Buf tmp;
-                auto e = do_read(tmp);
-                if (!e) {
+                auto is_space_pred = make_is_space_predicate(
+                    ctx.locale(), (common_options & localized) != 0,
+                    field_width);
+                CharT* out = buf;
+                auto e = read_until_space_ranged(ctx.range(), out, buf + N,
+                                                 is_space_pred, false);
+                if (!e && out == buf) {
                     return e;
                 }
-                auto thsep = ctx.locale()
-                                 .get((common_options & localized) != 0)
-                                 .thousands_separator();
-
-                auto it = tmp.begin();
-                for (; it != tmp.end(); ++it) {
-                    if (*it == thsep) {
-                        for (auto it2 = it; ++it2 != tmp.end();) {
-                            *it++ = SCN_MOVE(*it2);
-                        }
-                        break;
+                if (out == buf + N) {
+                    auto next = read_code_unit(ctx.range(), false);
+                    if (next && !is_space_pred(make_span(&next.value(), 1))) {
+                        return {error::value_out_of_range,
+                                "Integer literal too long"};
                     }
                 }
-
-                auto n =
-                    static_cast<std::size_t>(std::distance(tmp.begin(), it));
-                if (n == 0) {
-                    return {error::invalid_scanned_value,
-                            "Only a thousands separator found"};
-                }
-
-                buf = SCN_MOVE(tmp);
-                s = make_span(buf.data(), n);
+                s = make_span(buf, static_cast<std::size_t>(out - buf));
                 return {};
             }
 
@@ -435,9 +498,7 @@ namespace scn {
                                span<const CharT>& s,
                                std::true_type)
             {
-                if (SCN_UNLIKELY((format_options & allow_thsep) != 0)) {
-                    return _read_source(ctx, buf, s, std::false_type{});
-                }
+                SCN_UNUSED(buf);
                 auto ret = read_zero_copy(
                     ctx.range(), field_width != 0
                                      ? static_cast<std::ptrdiff_t>(field_width)
@@ -449,14 +510,70 @@ namespace scn {
                 return {};
             }
 
+            template <typename Locale, typename CharT>
+            static expected<std::ptrdiff_t> _read_num_localized(
+                const Locale& loc,
+                T& val,
+                const std::basic_string<CharT>& str,
+                int b,
+                std::true_type)
+            {
+                return loc.read_num(val, str, b);
+            }
+            // iostreams can't read integers wider than long long
+            template <typename Locale, typename CharT>
+            static expected<std::ptrdiff_t> _read_num_localized(
+                const Locale&,
+                T&,
+                const std::basic_string<CharT>&,
+                int,
+                std::false_type)
+            {
+                return error{error::invalid_operation,
+                             "Non-ASCII localized digits are not supported "
+                             "for integers wider than long long"};
+            }
+
             template <typename CharT>
             expected<typename span<const CharT>::iterator> parse_base_prefix(
                 span<const CharT> s,
                 int& b) const;
 
+            template <typename CharT>
+            expected<typename span<const CharT>::iterator> _parse_int_prefix(
+                span<const CharT> s,
+                bool& minus_sign,
+                bool& only_zero);
+
+            // _parse_int_prefix, with `base` and `format_options` known
+            // to be `Base` and `Options`
+            template <typename CharT, unsigned Base, unsigned Options>
+            expected<typename span<const CharT>::iterator> _parse_int_prefix(
+                span<const CharT> s,
+                bool& minus_sign,
+                bool& only_zero,
+                std::integral_constant<unsigned, Base>,
+                std::integral_constant<unsigned, Options>) const;
+
             template <typename CharT>
             expected<std::ptrdiff_t> _parse_int(T& val, span<const CharT> s);
 
+            // _parse_int, with `base` and `format_options` known to be
+            // `Base` and `Options`
+            template <unsigned Base, unsigned Options, typename CharT>
+            expected<std::ptrdiff_t> _parse_int_fixed_base(
+                T& val,
+                span<const CharT> s);
+
+            // Thousands separators are accepted between digits,
+            // if the sizes of the groups between them match `grouping`
+            template <typename CharT>
+            expected<std::ptrdiff_t> _parse_int_grouped(
+                T& val,
+                span<const CharT> s,
+                CharT thsep,
+                string_view grouping);
+
             template <typename CharT>
             expected<typename span<const CharT>::iterator> _parse_int_impl(
                 T& val,
@@ -475,9 +592,75 @@ namespace scn {
         template struct integer_scanner<unsigned int>;
         template struct integer_scanner<unsigned long>;
         template struct integer_scanner<unsigned long long>;
+#if SCN_HAS_INT128
+        template struct integer_scanner<int128>;
+        template struct integer_scanner<uint128>;
+#endif
         template struct integer_scanner<char>;
         template struct integer_scanner<wchar_t>;
 
+        // integer_scanner with the base and options fixed at compile time:
+        // no format string to parse, and no runtime branches on
+        // format_options
+        template <typename T, unsigned Base, unsigned Options>
+        struct static_integer_scanner : integer_scanner<T> {
+            static_assert(!std::is_same<T, char>::value &&
+                              !std::is_same<T, wchar_t>::value,
+                          "integer_format can't be used to scan characters");
+            static_assert(Base == 2 || Base == 8 || Base == 10 || Base == 16,
+                          "integer_format base has to be 2, 8, 10 or 16");
+            static_assert((Options & ~static_cast<unsigned>(
+                                         integer_format_unsigned |
+                                         integer_format_prefix)) == 0,
+                          "Invalid integer_format options");
+            static_assert(static_cast<unsigned>(integer_format_unsigned) ==
+                                  integer_scanner<T>::only_unsigned &&
+                              static_cast<unsigned>(integer_format_prefix) ==
+                                  integer_scanner<T>::allow_base_prefix,
+                          "integer_format_options out of sync");
+
+            static_integer_scanner()
+            {
+                this->base = static_cast<uint8_t>(Base);
+                this->format_options = static_cast<uint8_t>(Options);
+            }
+
+            template <typename Context>
+            error scan(T& val, Context& ctx)
+            {
+                using char_type = typename Context::char_type;
+
+                // Only used if the source isn't contiguous
+                char_type buf[integer_scanner<T>::max_literal_length];
+                span<const char_type> s{};
+                auto e = this->_read_source(
+                    ctx, buf, s,
+                    std::integral_constant<
+                        bool, Context::range_type::is_contiguous>{});
+                if (!e) {
+                    return e;
+                }
+
+                T tmp = 0;
+                SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+                auto ret =
+                    this->template _parse_int_fixed_base<Base, Options>(tmp,
+                                                                        s);
+                SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+                if (!ret) {
+                    return ret.error();
+                }
+                if (ret.value() != s.ssize()) {
+                    auto pb = putback_n(ctx.range(), s.ssize() - ret.value());
+                    if (!pb) {
+                        return pb;
+                    }
+                }
+                val = tmp;
+                return {};
+            }
+        };
+
         template <typename T>
         template <typename CharT>
         expected<typename span<const CharT>::iterator>
@@ -56,6 +56,11 @@ namespace scn {
     template <>
     struct scanner<long long> : public detail::integer_scanner<long long> {
     };
+#if SCN_HAS_INT128
+    template <>
+    struct scanner<int128> : public detail::integer_scanner<int128> {
+    };
+#endif
     template <>
     struct scanner<unsigned char>
         : public detail::integer_scanner<unsigned char> {
@@ -76,6 +81,11 @@ namespace scn {
     struct scanner<unsigned long long>
         : public detail::integer_scanner<unsigned long long> {
     };
+#if SCN_HAS_INT128
+    template <>
+    struct scanner<uint128> : public detail::integer_scanner<uint128> {
+    };
+#endif
     template <>
     struct scanner<float> : public detail::float_scanner<float> {
     };
@@ -114,6 +114,54 @@ namespace scn {
             return make_scan_result<Range>(SCN_MOVE(ret));
         }
 
+        template <unsigned Base,
+                  unsigned Options,
+                  typename Context,
+                  typename T>
+        error scan_integer_format_arg(Context& ctx, T& val)
+        {
+            auto e = skip_range_whitespace(ctx, false);
+            if (e) {
+                static_integer_scanner<T, Base, Options> scanner{};
+                e = scanner.scan(val, ctx);
+            }
+            if (!e) {
+                auto rb = ctx.range().reset_to_rollback_point();
+                if (!rb) {
+                    return rb;
+                }
+            }
+            return e;
+        }
+
+        template <unsigned Base,
+                  unsigned Options,
+                  typename Range,
+                  typename... Args>
+        auto scan_boilerplate_integer_format(Range&& r, Args&... a)
+            -> detail::scan_result_for_range<Range>
+        {
+            static_assert(sizeof...(Args) > 0,
+                          "Have to scan at least a single argument");
+            static_assert(SCN_CHECK_CONCEPT(ranges::range<Range>),
+                          "Input needs to be a Range");
+
+            // No type erasure or format string:
+            // every argument gets a scanner specialized for it
+            auto ctx = make_context(wrap(SCN_FWD(r)));
+            error err{};
+            bool dummy[] = {
+                (err && (err = scan_integer_format_arg<Base, Options>(ctx, a)),
+                 true)...};
+            SCN_UNUSED(dummy);
+            if (err) {
+                ctx.range().set_rollback_point();
+            }
+            return make_scan_result<Range>(
+                vscan_result<typename decltype(ctx)::range_type>{
+                    err, SCN_MOVE(ctx.range())});
+        }
+
     }  // namespace detail
 
     // scan
@@ -143,6 +191,41 @@ namespace scn {
     }
 #endif
 
+    /**
+     * Equivalent to \ref scan with a format string of space-separated
+     * argument specifiers, all with the base and options of `f`.
+     * The integer format is resolved at compile time, so nothing is parsed
+     * or dispatched at runtime. Every argument has to be an integer.
+     *
+     * \code{.cpp}
+     * unsigned a, b;
+     * // Same as scn::scan("ff 0x10", "{:x} {:x}", a, b);
+     * scn::scan("ff 0x10",
+     *           scn::integer_format<16, scn::integer_format_prefix>{}, a, b);
+     * // a == 255, b == 16
+     * \endcode
+     */
+#if SCN_DOXYGEN
+    template <typename Range,
+              unsigned Base,
+              unsigned Options,
+              typename... Args>
+    auto scan(Range&& r, integer_format<Base, Options> f, Args&... a)
+        -> detail::scan_result_for_range<Range>;
+#else
+    template <typename Range,
+              unsigned Base,
+              unsigned Options,
+              typename... Args>
+    SCN_NODISCARD auto scan(Range&& r,
+                            integer_format<Base, Options>,
+                            Args&... a) -> detail::scan_result_for_range<Range>
+    {
+        return detail::scan_boilerplate_integer_format<Base, Options>(
+            SCN_FWD(r), a...);
+    }
+#endif
+
     // default format
 
     /**
@@ -361,6 +444,138 @@ namespace scn {
     }
 #endif
 
+    /**
+     * Used to customize `parse_integers()`.
+     */
+    template <typename CharT>
+    struct parse_integers_options {
+        /// Base of the integers, between [2,36]
+        int base{10};
+        /**
+         * If set, up to one separator character is accepted between values,
+         * in addition to whitespace.
+         */
+        optional<CharT> separator{};
+
+        parse_integers_options() = default;
+        parse_integers_options(int b, optional<CharT> s = nullopt)
+            : base(b), separator(SCN_MOVE(s))
+        {
+        }
+    };
+
+    /**
+     * Result type of `parse_integers()`.
+     */
+    template <typename CharT>
+    struct parse_integers_result {
+        /// Number of values written
+        std::size_t count{0};
+        /**
+         * Where parsing stopped: past the last value read and the whitespace
+         * following it, or at the start of the value that couldn't be read.
+         */
+        const CharT* ptr{nullptr};
+        /// Why parsing stopped, if not because the input or `out` ran out
+        error err{};
+
+        explicit constexpr operator bool() const noexcept
+        {
+            return static_cast<bool>(err);
+        }
+    };
+
+    /**
+     * Parses whitespace-separated integers from \c str into \c out,
+     * until either of them runs out.
+     *
+     * Intended for long runs of numbers in contiguous memory:
+     * whitespace skipping and parsing go straight through `str`,
+     * without the setup of scanning one value at a time.
+     *
+     * Values have the same restrictions as with \ref parse_integer,
+     * and need to be followed by whitespace, the separator,
+     * or the end of \c str.
+     * On an invalid value, parsing is stopped at its beginning,
+     * and the error is returned along with the values parsed before it.
+     *
+     * \code{.cpp}
+     * std::vector<int> values(1000);
+     * auto ret = scn::parse_integers(source, scn::make_span(values));
+     * values.resize(ret.count);
+     * \endcode
+     */
+#if SCN_DOXYGEN
+    template <typename T, typename CharT>
+    parse_integers_result<CharT> parse_integers(
+        basic_string_view<CharT> str,
+        span<T> out,
+        parse_integers_options<CharT> options = {});
+#else
+    template <typename T, typename CharT>
+    SCN_NODISCARD parse_integers_result<CharT> parse_integers(
+        basic_string_view<CharT> str,
+        span<T> out,
+        parse_integers_options<CharT> options = {})
+    {
+        SCN_EXPECT(options.base >= 2 && options.base <= 36);
+        auto s = detail::simple_integer_scanner<T>{};
+
+        const CharT* it = str.data();
+        const auto end = str.data() + str.size();
+        std::size_t count = 0;
+        const auto skip_ws = [&]() {
+            while (it != end && detail::is_space(*it)) {
+                ++it;
+            }
+        };
+
+        skip_ws();
+        while (count != out.size() && it != end) {
+            if (count != 0 && options.separator &&
+                *it == *options.separator) {
+                ++it;
+                skip_ws();
+                if (it == end) {
+                    return {count, it,
+                            error{error::invalid_scanned_value,
+                                  "Expected integer after separator"}};
+                }
+            }
+
+            const auto value_begin = it;
+            SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
+            auto ret = s.scan_lower(span<const CharT>(it, end), out[count],
+                                    options.base);
+            SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
+            if (!ret) {
+                return {count, value_begin, ret.error()};
+            }
+            // scan_lower accepts a lone '-' or nothing at all
+            const auto digits_begin =
+                *it == detail::ascii_widen<CharT>('-') ? it + 1 : it;
+            if (ret.value() == digits_begin) {
+                return {count, value_begin,
+                        error{error::invalid_scanned_value,
+                              "Expected integer"}};
+            }
+            // A value needs to end at whitespace or a separator:
+            // "34abc" isn't parsed as 34
+            const auto value_end = ret.value();
+            if (value_end != end && !detail::is_space(*value_end) &&
+                !(options.separator && *value_end == *options.separator)) {
+                return {count, value_begin,
+                        error{error::invalid_scanned_value,
+                              "Unexpected character after integer"}};
+            }
+            it = value_end;
+            ++count;
+            skip_ws();
+        }
+        return {count, it, {}};
+    }
+#endif
+
     /**
      * Parses float into \c val from \c str.
      * Returns a pointer past the last character read, or an error.
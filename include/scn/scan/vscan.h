@@ -195,6 +195,8 @@ namespace scn {
     SCN_VSCAN_DECLARE(std::wstring, wstring_wrapped, wstring_char);
     SCN_VSCAN_DECLARE(file&, file_ref_wrapped, file_ref_char);
     SCN_VSCAN_DECLARE(wfile&, wfile_ref_wrapped, wfile_ref_char);
+    SCN_VSCAN_DECLARE(fd_file&, fd_file_ref_wrapped, fd_file_ref_char);
+    SCN_VSCAN_DECLARE(wfd_file&, wfd_file_ref_wrapped, wfd_file_ref_char);
 
 #endif  // !SCN_HEADER_ONLY
 
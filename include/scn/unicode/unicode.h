@@ -26,6 +26,8 @@
 #include "utf16.h"
 #include "utf8.h"
 
+#include <cstring>
+
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
@@ -235,6 +237,113 @@ namespace scn {
             SCN_MAKE_UTF_TAG(typename std::iterator_traits<I>::value_type));
     }
 
+    namespace detail {
+        template <typename WChar>
+        struct transcode_result {
+            /// One past the last code unit read
+            const char* in;
+            /// One past the last code unit written
+            WChar* out;
+            /// `error::invalid_encoding`, if transcoding stopped at
+            /// an invalid sequence
+            error err;
+        };
+
+        /**
+         * Transcode as much of the UTF-8 in `[begin, end)` as possible into
+         * UTF-16 or UTF-32, depending on the size of `WChar`.
+         * `out` must have room for `end - begin` code units.
+         *
+         * A code point cut off by `end` is left untranscoded,
+         * to be completed by the next block.
+         * An invalid sequence stops transcoding:
+         * everything before it is still written to `out`.
+         */
+        template <typename WChar>
+        transcode_result<WChar> transcode_utf8_block(
+            const char* begin,
+            const char* end,
+            WChar* out)
+        {
+            constexpr std::uint64_t ascii_mask = 0x8080808080808080ull;
+            while (begin != end) {
+                // Runs of ASCII are copied eight bytes at a time
+                while (end - begin >= 8) {
+                    std::uint64_t word{};
+                    std::memcpy(&word, begin, 8);
+                    if ((word & ascii_mask) != 0) {
+                        break;
+                    }
+                    for (int i = 0; i < 8; ++i) {
+                        *out++ = static_cast<WChar>(begin[i]);
+                    }
+                    begin += 8;
+                }
+                if (begin == end) {
+                    break;
+                }
+                if (static_cast<unsigned char>(*begin) < 0x80) {
+                    *out++ = static_cast<WChar>(*begin++);
+                    continue;
+                }
+
+                const auto len = utf8::get_sequence_length(*begin);
+                if (len == 0) {
+                    return {begin, out,
+                            error(error::invalid_encoding,
+                                  "Invalid lead byte for utf8")};
+                }
+                if (end - begin < len) {
+                    break;
+                }
+                code_point cp{};
+                auto ret = utf8::parse_code_point(begin, begin + len, cp);
+                if (!ret) {
+                    return {begin, out, ret.error()};
+                }
+                begin = ret.value();
+
+                const auto cp_value = static_cast<std::uint32_t>(cp);
+                if (sizeof(WChar) == 2 && cp_value > 0xffffu) {
+                    *out++ =
+                        static_cast<WChar>((cp_value >> 10u) + lead_offset);
+                    *out++ = static_cast<WChar>((cp_value & 0x3ffu) +
+                                                trail_surrogate_min);
+                }
+                else {
+                    *out++ = static_cast<WChar>(cp_value);
+                }
+            }
+            return {begin, out, {}};
+        }
+
+        /**
+         * Length of the UTF-8 sequence the UTF-16 or UTF-32 code unit
+         * `ch` was transcoded from.
+         * A UTF-16 surrogate pair comes from a 4-byte sequence,
+         * so both halves count for two bytes.
+         */
+        template <typename WChar>
+        SCN_CONSTEXPR14 std::size_t utf8_length_of(WChar ch) noexcept
+        {
+            const auto cp = static_cast<std::uint32_t>(ch);
+            if (sizeof(WChar) == 2 && cp >= lead_surrogate_min &&
+                cp <= trail_surrogate_max) {
+                return 2;
+            }
+            if (cp < 0x80u) {
+                return 1;
+            }
+            if (cp < 0x800u) {
+                return 2;
+            }
+            if (cp < 0x10000u) {
+                return 3;
+            }
+            return 4;
+        }
+    }  // namespace detail
+
 #undef SCN_MAKE_UTF_TAG
 
     SCN_END_NAMESPACE
@@ -21,9 +21,23 @@
 
 #include <scn/detail/error.h>
 #include <scn/detail/file.h>
+#include <scn/unicode/unicode.h>
 #include <scn/util/expected.h>
 
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#if SCN_HAS_READAHEAD_FILE
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 #if SCN_POSIX
 #include <fcntl.h>
@@ -32,6 +46,18 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+// `linux` is a predefined macro in GNU mode:
+// the header name is given as a string to keep it from being expanded
+#if defined(__linux__) && SCN_HAS_INCLUDE("linux/io_uring.h")
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(__NR_io_uring_register)
+#define SCN_HAS_IO_URING 1
+#endif
+#endif
+
 #elif SCN_WINDOWS
 
 #ifdef WIN32_LEAN_AND_MEAN
@@ -60,6 +86,10 @@
 
 #endif
 
+#ifndef SCN_HAS_IO_URING
+#define SCN_HAS_IO_URING 0
+#endif
+
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
@@ -73,7 +103,9 @@ namespace scn {
 #endif
         }
 
-        SCN_FUNC byte_mapped_file::byte_mapped_file(const char* filename)
+        SCN_FUNC byte_mapped_file::byte_mapped_file(
+            const char* filename,
+            const mapped_file_options& opt)
         {
 #if SCN_POSIX
             int fd = open(filename, O_RDONLY);
@@ -90,16 +122,36 @@ namespace scn {
             }
             auto size = s.st_size;
 
-            auto ptr =
-                static_cast<char*>(mmap(nullptr, static_cast<size_t>(size),
-                                        PROT_READ, MAP_PRIVATE, fd, 0));
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (opt.populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            auto ptr = static_cast<char*>(mmap(
+                nullptr, static_cast<size_t>(size), PROT_READ, flags, fd, 0));
             if (ptr == MAP_FAILED) {
                 close(fd);
                 return;
             }
 
+            // Advice is only a hint, failures are ignored
+            if (opt.sequential) {
+                madvise(ptr, static_cast<size_t>(size), MADV_SEQUENTIAL);
+            }
+            if (opt.will_need) {
+                madvise(ptr, static_cast<size_t>(size), MADV_WILLNEED);
+            }
+#ifdef MADV_HUGEPAGE
+            if (opt.huge_pages) {
+                madvise(ptr, static_cast<size_t>(size), MADV_HUGEPAGE);
+            }
+#endif
+
             m_file.handle = fd;
             m_map = span<char>{ptr, static_cast<size_t>(size)};
+            m_discarded = ptr;
+            m_drop_consumed = opt.drop_consumed;
 #elif SCN_WINDOWS
             auto f = ::CreateFileA(
                 filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
@@ -138,123 +190,241 @@ namespace scn {
             m_file.handle = f;
             m_map_handle.handle = h;
             m_map = span<char>{static_cast<char*>(start), size};
+            m_discarded = m_map.data();
+            // No equivalents for the access hints
+            SCN_UNUSED(opt);
 #else
             SCN_UNUSED(filename);
+            SCN_UNUSED(opt);
 #endif
         }
 
-        SCN_FUNC void byte_mapped_file::_destruct()
+        SCN_FUNC void byte_mapped_file::discard_until(
+            iterator it) const noexcept
         {
+            SCN_EXPECT(it >= m_map.begin() && it <= m_map.end());
+#if SCN_POSIX
+            if (!m_drop_consumed) {
+                return;
+            }
+            // Only whole pages can be released
+            static const auto page_size =
+                static_cast<std::ptrdiff_t>(sysconf(_SC_PAGESIZE));
+            const auto end = m_map.data() +
+                             (it - m_map.data()) / page_size * page_size;
+            if (end <= m_discarded) {
+                return;
+            }
+            madvise(const_cast<char*>(m_discarded),
+                    static_cast<size_t>(end - m_discarded), MADV_DONTNEED);
+            m_discarded = end;
+#else
+            SCN_UNUSED(it);
+#endif
+        }
+
+        SCN_FUNC byte_windowed_mapped_file::byte_windowed_mapped_file(
+            const char* filename,
+            std::size_t window_size)
+        {
+#if SCN_POSIX
+            int fd = open(filename, O_RDONLY);
+            if (fd == -1) {
+                return;
+            }
+
+            struct stat s {
+            };
+            if (fstat(fd, &s) == -1) {
+                close(fd);
+                return;
+            }
+
+            m_file.handle = fd;
+            m_file_size = static_cast<std::uint64_t>(s.st_size);
+            m_granularity = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#elif SCN_WINDOWS
+            auto f = ::CreateFileA(
+                filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (f == INVALID_HANDLE_VALUE) {
+                return;
+            }
+
+            LARGE_INTEGER size;
+            if (::GetFileSizeEx(f, &size) == 0) {
+                ::CloseHandle(f);
+                return;
+            }
+
+            // An empty file can't be mapped
+            if (size.QuadPart != 0) {
+                auto h = ::CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0,
+                                              nullptr);
+                if (h == INVALID_HANDLE_VALUE || h == nullptr) {
+                    ::CloseHandle(f);
+                    return;
+                }
+                m_map_handle.handle = h;
+            }
+
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+
+            m_file.handle = f;
+            m_file_size = static_cast<std::uint64_t>(size.QuadPart);
+            m_granularity =
+                static_cast<std::size_t>(info.dwAllocationGranularity);
+#else
+            SCN_UNUSED(filename);
+            SCN_UNUSED(window_size);
+            return;
+#endif
+
+            // Round up to a multiple of the granularity
+            m_window_size = (max(window_size, std::size_t{1}) +
+                             m_granularity - 1) /
+                            m_granularity * m_granularity;
+        }
+
+        SCN_FUNC bool byte_windowed_mapped_file::_map_window(
+            std::uint64_t begin,
+            std::uint64_t end) const
+        {
+            SCN_EXPECT(valid());
+            SCN_EXPECT(begin <= end && end <= m_file_size);
+
+            _unmap_window();
+
+            const auto offset = begin / m_granularity * m_granularity;
+            auto size = max(static_cast<std::uint64_t>(m_window_size),
+                            (end - offset + m_granularity - 1) /
+                                m_granularity * m_granularity);
+            size = min(size, m_file_size - offset);
+            if (size > std::numeric_limits<std::size_t>::max()) {
+                return false;
+            }
+
+#if SCN_POSIX
+            auto ptr = static_cast<char*>(
+                mmap(nullptr, static_cast<std::size_t>(size), PROT_READ,
+                     MAP_PRIVATE, m_file.handle, static_cast<off_t>(offset)));
+            if (ptr == MAP_FAILED) {
+                return false;
+            }
+#elif SCN_WINDOWS
+            auto ptr = static_cast<char*>(::MapViewOfFile(
+                m_map_handle.handle, FILE_MAP_READ,
+                static_cast<DWORD>(offset >> 32u),
+                static_cast<DWORD>(offset & 0xffffffffu),
+                static_cast<SIZE_T>(size)));
+            if (!ptr) {
+                return false;
+            }
+#endif
+
+#if SCN_POSIX || SCN_WINDOWS
+            m_map = span<char>{ptr, static_cast<std::size_t>(size)};
+            m_map_offset = offset;
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        SCN_FUNC void byte_windowed_mapped_file::_unmap_window() const
+        {
+            if (m_map.size() == 0) {
+                return;
+            }
 #if SCN_POSIX
             munmap(m_map.data(), m_map.size());
+#elif SCN_WINDOWS
+            ::UnmapViewOfFile(m_map.data());
+#endif
+            m_map = span<char>{};
+        }
+
+        SCN_FUNC void byte_windowed_mapped_file::_destruct()
+        {
+            _unmap_window();
+#if SCN_POSIX
             close(m_file.handle);
 #elif SCN_WINDOWS
-            ::CloseHandle(m_map_handle.handle);
+            if (m_map_handle.handle !=
+                native_file_handle::invalid().handle) {
+                ::CloseHandle(m_map_handle.handle);
+            }
             ::CloseHandle(m_file.handle);
             m_map_handle = native_file_handle::invalid();
 #endif
 
             m_file = native_file_handle::invalid();
-            m_map = span<char>{};
 
             SCN_ENSURE(!valid());
         }
 
-    }  // namespace detail
-
-    namespace detail {
-        template <typename CharT>
-        struct basic_file_iterator_access {
-            using iterator = typename basic_file<CharT>::iterator;
-
-            basic_file_iterator_access(const iterator& it) : self(it) {}
-
-            SCN_NODISCARD expected<CharT> deref() const
-            {
-                SCN_EXPECT(self.m_file);
-
-                if (self.m_file->m_buffer.empty()) {
-                    // no chars have been read
-                    return self.m_file->_read_single();
-                }
-                if (!self.m_last_error) {
-                    // last read failed
-                    return self.m_last_error;
-                }
-                return self.m_file->_get_char_at(self.m_current);
-            }
+        SCN_FUNC void byte_mapped_file::_destruct()
+        {
+#if SCN_POSIX
+            munmap(m_map.data(), m_map.size());
+            close(m_file.handle);
+#elif SCN_WINDOWS
+            ::CloseHandle(m_map_handle.handle);
+            ::CloseHandle(m_file.handle);
+            m_map_handle = native_file_handle::invalid();
+#endif
 
-            SCN_NODISCARD bool eq(const iterator& o) const
-            {
-                if (self.m_file && (self.m_file == o.m_file || !o.m_file)) {
-                    if (self.m_file->_is_at_end(self.m_current) &&
-                        self.m_last_error.code() != error::end_of_range &&
-                        !o.m_file) {
-                        self.m_last_error = error{};
-                        auto r = self.m_file->_read_single();
-                        if (!r) {
-                            self.m_last_error = r.error();
-                            return !o.m_file || self.m_current == o.m_current ||
-                                   o.m_last_error.code() == error::end_of_range;
-                        }
-                    }
-                }
+            m_file = native_file_handle::invalid();
+            m_map = span<char>{};
 
-                // null file == null file
-                if (!self.m_file && !o.m_file) {
-                    return true;
-                }
-                // null file == eof file
-                if (!self.m_file && o.m_file) {
-                    // lhs null, rhs potentially eof
-                    return o.m_last_error.code() == error::end_of_range;
-                }
-                // eof file == null file
-                if (self.m_file && !o.m_file) {
-                    // rhs null, lhs potentially eof
-                    return self.m_last_error.code() == error::end_of_range;
-                }
-                // eof file == eof file
-                if (self.m_last_error == o.m_last_error &&
-                    self.m_last_error.code() == error::end_of_range) {
-                    return true;
-                }
+            SCN_ENSURE(!valid());
+        }
 
-                return self.m_file == o.m_file && self.m_current == o.m_current;
+        SCN_FUNC file_read_mode get_file_read_mode(FILE* f) noexcept
+        {
+#if SCN_POSIX
+            // Reading a regular file in blocks never blocks for longer than
+            // reading it one character at a time would.
+            // Pipes, ttys and sockets may, so they're read one-by-one.
+            struct stat s {
+            };
+            if (fstat(fileno(f), &s) == 0 && S_ISREG(s.st_mode)) {
+                return file_read_mode::block;
             }
-
-            const iterator& self;
-        };
+#else
+            SCN_UNUSED(f);
+#endif
+            return file_read_mode::single;
+        }
     }  // namespace detail
 
-    template <>
-    SCN_FUNC expected<char> basic_file<char>::iterator::operator*() const
-    {
-        return detail::basic_file_iterator_access<char>(*this).deref();
-    }
-    template <>
-    SCN_FUNC expected<wchar_t> basic_file<wchar_t>::iterator::operator*() const
-    {
-        return detail::basic_file_iterator_access<wchar_t>(*this).deref();
-    }
-
-    template <>
-    SCN_FUNC bool basic_file<char>::iterator::operator==(
-        const basic_file<char>::iterator& o) const
-    {
-        return detail::basic_file_iterator_access<char>(*this).eq(o);
-    }
-    template <>
-    SCN_FUNC bool basic_file<wchar_t>::iterator::operator==(
-        const basic_file<wchar_t>::iterator& o) const
-    {
-        return detail::basic_file_iterator_access<wchar_t>(*this).eq(o);
-    }
-
     template <>
     SCN_FUNC expected<char> file::_read_single() const
     {
         SCN_EXPECT(valid());
+        if (SCN_UNLIKELY(m_read_mode == detail::file_read_mode::unknown)) {
+            m_read_mode = detail::get_file_read_mode(m_file);
+        }
+        if (m_read_mode == detail::file_read_mode::block) {
+            const auto prev_size = m_buffer.size();
+            m_buffer.resize(prev_size + detail::file_block_size);
+            const auto n = std::fread(&m_buffer[prev_size], 1,
+                                      detail::file_block_size, m_file);
+            m_buffer.resize(prev_size + n);
+            if (n == 0) {
+                if (std::feof(m_file) != 0) {
+                    return error(error::end_of_range, "EOF");
+                }
+                if (std::ferror(m_file) != 0) {
+                    return error(error::source_error, "fread error");
+                }
+                return error(error::unrecoverable_source_error,
+                             "Unknown fread error");
+            }
+            return m_buffer[prev_size];
+        }
+
         int tmp = std::fgetc(m_file);
         if (tmp == EOF) {
             if (std::feof(m_file) != 0) {
@@ -274,6 +444,78 @@ namespace scn {
     SCN_FUNC expected<wchar_t> wfile::_read_single() const
     {
         SCN_EXPECT(valid());
+        if (SCN_UNLIKELY(m_read_mode == detail::file_read_mode::unknown)) {
+            m_read_mode = detail::get_file_read_mode(m_file);
+            // fgetwc decodes with LC_CTYPE: only bypass it if the file is
+            // known to be UTF-8.
+            // Wide-oriented streams can't be read with fread
+            if (!m_utf8 || std::fwide(m_file, 0) > 0) {
+                m_read_mode = detail::file_read_mode::single;
+            }
+        }
+        if (m_read_mode == detail::file_read_mode::block) {
+            char bytes[detail::file_block_size + sizeof(m_carry)];
+            while (true) {
+                std::memcpy(bytes, m_carry, m_carry_size);
+                const auto n = std::fread(bytes + m_carry_size, 1,
+                                          detail::file_block_size, m_file);
+                if (n == 0) {
+                    if (std::feof(m_file) != 0) {
+                        if (m_carry_size != 0) {
+                            return error(
+                                error::invalid_encoding,
+                                "Incomplete UTF-8 sequence at end of file");
+                        }
+                        return error(error::end_of_range, "EOF");
+                    }
+                    if (std::ferror(m_file) != 0) {
+                        return error(error::source_error, "fread error");
+                    }
+                    return error(error::unrecoverable_source_error,
+                                 "Unknown fread error");
+                }
+
+                const auto total = m_carry_size + n;
+                const auto prev_size = m_buffer.size();
+                // Every code point takes at least as many bytes in UTF-8
+                // as code units in UTF-16 or UTF-32
+                m_buffer.resize(prev_size + total);
+                auto ret = detail::transcode_utf8_block(
+                    bytes, bytes + total, &m_buffer[prev_size]);
+                m_buffer.resize(
+                    static_cast<std::size_t>(ret.out - &m_buffer[0]));
+                const auto rest =
+                    static_cast<std::size_t>(bytes + total - ret.in);
+                if (!ret.err) {
+                    if (m_buffer.size() == prev_size) {
+                        return ret.err;
+                    }
+                    // Give back the invalid sequence and everything after
+                    // it, to be read (and fail) again after the valid
+                    // characters before it
+                    m_carry_size = 0;
+                    if (rest > static_cast<std::size_t>(
+                                   std::numeric_limits<long>::max()) ||
+                        std::fseek(m_file, -static_cast<long>(rest),
+                                   SEEK_CUR) != 0) {
+                        // The position of the file is now unknown
+                        m_buffer.resize(prev_size);
+                        return error(error::unrecoverable_source_error,
+                                     "fseek error");
+                    }
+                    return m_buffer[prev_size];
+                }
+                m_carry_size = rest;
+                std::memcpy(m_carry, ret.in, m_carry_size);
+
+                // Only a part of a single code point was read:
+                // keep reading until it's complete
+                if (m_buffer.size() != prev_size) {
+                    return m_buffer[prev_size];
+                }
+            }
+        }
+
         wint_t tmp = std::fgetwc(m_file);
         if (tmp == WEOF) {
             if (std::feof(m_file) != 0) {
@@ -291,21 +533,826 @@ namespace scn {
     }
 
     template <>
-    SCN_FUNC void file::_sync_until(std::size_t pos) noexcept
+    SCN_FUNC bool file::_sync_until(std::size_t pos) noexcept
     {
+        SCN_EXPECT(pos >= m_buffer_offset);
+        const auto n = m_buffer.size() - (pos - m_buffer_offset);
+        if (n == 0) {
+            return true;
+        }
+        // Files read in blocks are regular files, and can be seeked back in
+        // one call.
+        // ungetc is only guaranteed to work for a single character,
+        // so it's used only as a fallback, for pipes, ttys and the like.
+        if (m_read_mode == detail::file_read_mode::block &&
+            n <= static_cast<std::size_t>(
+                     std::numeric_limits<long>::max()) &&
+            std::fseek(m_file, -static_cast<long>(n), SEEK_CUR) == 0) {
+            return true;
+        }
         for (auto it = m_buffer.rbegin();
-             it != m_buffer.rend() - static_cast<std::ptrdiff_t>(pos); ++it) {
-            std::ungetc(static_cast<unsigned char>(*it), m_file);
+             it != m_buffer.rend() -
+                       static_cast<std::ptrdiff_t>(pos - m_buffer_offset);
+             ++it) {
+            if (std::ungetc(static_cast<unsigned char>(*it), m_file) == EOF) {
+                return false;
+            }
         }
+        return true;
     }
     template <>
-    SCN_FUNC void wfile::_sync_until(std::size_t pos) noexcept
+    SCN_FUNC bool wfile::_sync_until(std::size_t pos) noexcept
     {
+        SCN_EXPECT(pos >= m_buffer_offset);
+        if (m_read_mode == detail::file_read_mode::block) {
+            // Characters were decoded from UTF-8 bytes:
+            // seek back over the bytes they came from,
+            // and the undecoded bytes at the end
+            auto n = m_carry_size;
+            for (auto i = pos - m_buffer_offset; i < m_buffer.size(); ++i) {
+                n += detail::utf8_length_of(m_buffer[i]);
+            }
+            m_carry_size = 0;
+            // The stream is byte-oriented, so there's no ungetwc fallback
+            return n == 0 ||
+                   (n <= static_cast<std::size_t>(
+                             std::numeric_limits<long>::max()) &&
+                    std::fseek(m_file, -static_cast<long>(n), SEEK_CUR) == 0);
+        }
         for (auto it = m_buffer.rbegin();
-             it != m_buffer.rend() - static_cast<std::ptrdiff_t>(pos); ++it) {
-            std::ungetwc(static_cast<wint_t>(*it), m_file);
+             it != m_buffer.rend() -
+                       static_cast<std::ptrdiff_t>(pos - m_buffer_offset);
+             ++it) {
+            if (std::ungetwc(static_cast<wint_t>(*it), m_file) == WEOF) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    SCN_FUNC expected<wchar_t> transcoding_mapped_wfile::_read_single() const
+    {
+        SCN_EXPECT(valid());
+        const auto map_end = m_map.data() + m_map.size();
+        if (m_input == map_end) {
+            return error(error::end_of_range, "EOF");
+        }
+
+        const auto chunk_end =
+            m_input +
+            detail::min(detail::mapped_transcode_chunk_size,
+                        static_cast<std::size_t>(map_end - m_input));
+        const auto prev_size = m_buffer.size();
+        // Every code point takes at least as many bytes in UTF-8
+        // as code units in UTF-16 or UTF-32
+        m_buffer.resize(prev_size +
+                        static_cast<std::size_t>(chunk_end - m_input));
+        auto ret = detail::transcode_utf8_block(m_input, chunk_end,
+                                                &m_buffer[prev_size]);
+        m_buffer.resize(static_cast<std::size_t>(ret.out - &m_buffer[0]));
+        m_input = ret.in;
+
+        if (m_buffer.size() == prev_size) {
+            if (!ret.err) {
+                return ret.err;
+            }
+            // A chunk always holds at least one complete code point,
+            // unless the file ends in the middle of one
+            return error(error::invalid_encoding,
+                         "Incomplete UTF-8 sequence at end of file");
+        }
+        return m_buffer[prev_size];
+    }
+
+    SCN_FUNC void transcoding_mapped_wfile::_set_rollback_point(
+        std::size_t pos) const noexcept
+    {
+        SCN_EXPECT(pos >= m_buffer_offset);
+        const auto n = pos - m_buffer_offset;
+        if (n < detail::file_window_discard_threshold) {
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            m_buffer_input += detail::utf8_length_of(m_buffer[i]);
+        }
+        m_buffer.erase(0, n);
+        m_buffer_offset = pos;
+        discard_until(m_buffer_input);
+    }
+
+    namespace detail {
+        SCN_FUNC std::ptrdiff_t read_native(native_file_handle h,
+                                            void* buf,
+                                            std::size_t size) noexcept
+        {
+#if SCN_POSIX
+            while (true) {
+                const auto n = ::read(h.handle, buf, size);
+                if (n == -1 && errno == EINTR) {
+                    continue;
+                }
+                return static_cast<std::ptrdiff_t>(n);
+            }
+#elif SCN_WINDOWS
+            DWORD n{0};
+            const auto to_read = static_cast<DWORD>(
+                min(size, static_cast<std::size_t>(0x7fffffff)));
+            if (::ReadFile(h.handle, buf, to_read, &n, nullptr) == 0) {
+                // Write end of a pipe closed: EOF
+                if (::GetLastError() == ERROR_BROKEN_PIPE) {
+                    return 0;
+                }
+                return -1;
+            }
+            return static_cast<std::ptrdiff_t>(n);
+#else
+            SCN_UNUSED(h);
+            SCN_UNUSED(buf);
+            SCN_UNUSED(size);
+            return -1;
+#endif
+        }
+
+        SCN_FUNC bool seek_back_native(native_file_handle h,
+                                       std::size_t n) noexcept
+        {
+#if SCN_POSIX
+            return ::lseek(h.handle, -static_cast<off_t>(n), SEEK_CUR) !=
+                   static_cast<off_t>(-1);
+#elif SCN_WINDOWS
+            LARGE_INTEGER dist;
+            dist.QuadPart = -static_cast<LONGLONG>(n);
+            return ::SetFilePointerEx(h.handle, dist, nullptr, FILE_CURRENT) !=
+                   0;
+#else
+            SCN_UNUSED(h);
+            SCN_UNUSED(n);
+            return false;
+#endif
+        }
+
+        SCN_FUNC native_file_handle open_native(const char* filename) noexcept
+        {
+#if SCN_POSIX
+            return {::open(filename, O_RDONLY)};
+#elif SCN_WINDOWS
+            return {::CreateFileA(filename, GENERIC_READ,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                                  nullptr)};
+#else
+            SCN_UNUSED(filename);
+            return native_file_handle::invalid();
+#endif
+        }
+
+        SCN_FUNC void close_native(native_file_handle h) noexcept
+        {
+#if SCN_POSIX
+            ::close(h.handle);
+#elif SCN_WINDOWS
+            ::CloseHandle(h.handle);
+#else
+            SCN_UNUSED(h);
+#endif
         }
+
+        // Appends a block to `buf`, with a single read if possible.
+        // A wide character can be split between two reads, in which case
+        // reading is continued until it's complete.
+        template <typename CharT>
+        expected<CharT> read_native_block(native_file_handle h,
+                                          std::basic_string<CharT>& buf)
+        {
+            const auto prev_size = buf.size();
+            buf.resize(prev_size + file_block_size);
+            auto data = reinterpret_cast<char*>(&buf[prev_size]);
+            const auto max_bytes = file_block_size * sizeof(CharT);
+
+            std::size_t n = 0;
+            do {
+                const auto ret = read_native(h, data + n, max_bytes - n);
+                if (ret < 0) {
+                    buf.resize(prev_size);
+                    return error(error::source_error, "read error");
+                }
+                if (ret == 0) {
+                    break;
+                }
+                n += static_cast<std::size_t>(ret);
+            } while (n % sizeof(CharT) != 0);
+
+            buf.resize(prev_size + n / sizeof(CharT));
+            if (n == 0) {
+                return error(error::end_of_range, "EOF");
+            }
+            if (n < sizeof(CharT)) {
+                return error(error::invalid_encoding,
+                             "Incomplete character at end of file");
+            }
+            return buf[prev_size];
+        }
+    }  // namespace detail
+
+    template <>
+    SCN_FUNC expected<char> fd_file::_read_single() const
+    {
+        SCN_EXPECT(valid());
+        return detail::read_native_block(m_handle, m_buffer);
     }
+    template <>
+    SCN_FUNC expected<wchar_t> wfd_file::_read_single() const
+    {
+        SCN_EXPECT(valid());
+        return detail::read_native_block(m_handle, m_buffer);
+    }
+
+#if SCN_HAS_READAHEAD_FILE
+    namespace detail {
+        // Whether reads from `h` always complete:
+        // true for regular files, false for pipes, sockets and ttys
+        static bool is_regular_file_native(native_file_handle h) noexcept
+        {
+#if SCN_POSIX
+            struct stat s {
+            };
+            return ::fstat(h.handle, &s) == 0 && S_ISREG(s.st_mode);
+#elif SCN_WINDOWS
+            return ::GetFileType(h.handle) == FILE_TYPE_DISK;
+#else
+            SCN_UNUSED(h);
+            return false;
+#endif
+        }
+
+        struct readahead_state {
+            enum block_state { empty, filled, eof, failed };
+
+            struct block {
+                std::atomic<block_state> state{empty};
+                std::size_t size{0};
+                std::unique_ptr<char[]> data{
+                    new char[readahead_block_size]};
+            };
+
+            // Number of times the state of a block is checked,
+            // before going to sleep waiting for it to change
+            static constexpr int spin_count = 1 << 10;
+
+            readahead_state(native_file_handle h, bool owns)
+                : file(h), owns_file(owns)
+            {
+            }
+
+            // Wait until `pred` holds; the other thread calls
+            // notify() with the same `waiting` and `cv` after changing it.
+            // Spins for a while first: with fast storage, the block is
+            // usually handed over before the thread would have gone to
+            // sleep.
+            template <typename Predicate>
+            void wait(std::atomic<bool>& waiting,
+                      std::condition_variable& cv,
+                      Predicate pred)
+            {
+                for (int i = 0; i < spin_count; ++i) {
+                    if (pred()) {
+                        return;
+                    }
+                }
+                std::unique_lock<std::mutex> lock{mutex};
+                waiting.store(true);
+                cv.wait(lock, pred);
+                waiting.store(false);
+            }
+            // Both the store before the call, and the load of `waiting`,
+            // are sequentially consistent: either the waiting thread sees
+            // the change, or this thread sees it waiting.
+            // Taking the lock makes sure the waiting thread is either
+            // asleep, or yet to check the predicate.
+            void notify(std::atomic<bool>& waiting,
+                        std::condition_variable& cv)
+            {
+                if (waiting.load()) {
+                    {
+                        std::lock_guard<std::mutex> lock{mutex};
+                    }
+                    cv.notify_one();
+                }
+            }
+
+            // Runs on the reading thread
+            void read_loop() noexcept
+            {
+                for (std::size_t i = 0;; i ^= 1u) {
+                    auto& b = blocks[i];
+                    wait(reader_waiting, block_emptied, [&] {
+                        return stop.load() || b.state.load() == empty;
+                    });
+                    if (stop.load()) {
+                        return;
+                    }
+
+                    // The block is only touched by this thread while it's
+                    // empty, and the state is stored last
+                    const auto n =
+                        read_native(file, b.data.get(), readahead_block_size);
+                    b.size = n > 0 ? static_cast<std::size_t>(n) : 0;
+                    b.state.store(n > 0 ? filled : (n == 0 ? eof : failed));
+                    notify(scanner_waiting, block_filled);
+                    if (n <= 0) {
+                        return;
+                    }
+                }
+            }
+
+            // Only used when a thread goes to sleep
+            std::mutex mutex{};
+            // Signaled by the reading thread when a block is filled
+            std::condition_variable block_filled{};
+            std::atomic<bool> scanner_waiting{false};
+            // Signaled by the scanning thread when a block is given back,
+            // or when the reading thread is asked to stop
+            std::condition_variable block_emptied{};
+            std::atomic<bool> reader_waiting{false};
+            block blocks[2];
+            // Index of the next block to be used by the scanning thread
+            std::size_t next{0};
+            std::atomic<bool> stop{false};
+            native_file_handle file;
+            bool owns_file;
+            std::thread thread{};
+        };
+
+        SCN_FUNC byte_readahead_file::byte_readahead_file(
+            native_file_handle h,
+            bool owns_handle)
+        {
+            // A read from a pipe or a socket may never complete,
+            // which would keep the destructor from joining the thread
+            if (!is_regular_file_native(h)) {
+                if (owns_handle) {
+                    close_native(h);
+                }
+                return;
+            }
+
+            std::unique_ptr<readahead_state> state{
+                new readahead_state{h, owns_handle}};
+            state->thread =
+                std::thread{&readahead_state::read_loop, state.get()};
+            m_state = state.release();
+        }
+
+        SCN_FUNC expected<span<const char>>
+        byte_readahead_file::_acquire_block() const
+        {
+            SCN_EXPECT(valid());
+            auto& b = m_state->blocks[m_state->next];
+            m_state->wait(m_state->scanner_waiting, m_state->block_filled,
+                          [&] {
+                              return b.state.load() != readahead_state::empty;
+                          });
+            if (b.state.load() == readahead_state::failed) {
+                return error(error::source_error, "read error");
+            }
+            // EOF is sticky: the block is never given back
+            return span<const char>{b.data.get(), b.size};
+        }
+
+        SCN_FUNC void byte_readahead_file::_release_block() const noexcept
+        {
+            SCN_EXPECT(valid());
+            auto& b = m_state->blocks[m_state->next];
+            SCN_EXPECT(b.state.load() == readahead_state::filled);
+            b.state.store(readahead_state::empty);
+            m_state->notify(m_state->reader_waiting, m_state->block_emptied);
+            m_state->next ^= 1u;
+        }
+
+        SCN_FUNC void byte_readahead_file::_destruct() noexcept
+        {
+            m_state->stop.store(true);
+            {
+                std::lock_guard<std::mutex> lock{m_state->mutex};
+            }
+            m_state->block_emptied.notify_one();
+            // A read already in progress is waited for
+            m_state->thread.join();
+            if (m_state->owns_file) {
+                close_native(m_state->file);
+            }
+            delete m_state;
+            m_state = nullptr;
+        }
+    }  // namespace detail
+#endif  // SCN_HAS_READAHEAD_FILE
+
+    namespace detail {
+        struct uring_state {
+            struct block {
+                std::unique_ptr<char[]> data{};
+                std::uint64_t offset{0};
+                // Bytes read, or -errno
+                int result{0};
+                bool done{false};
+            };
+
+            uring_state(native_file_handle h,
+                        bool owns,
+                        const uring_file_options& o)
+                : opt(o), file(h), owns_file(owns)
+            {
+                if (opt.queue_depth == 0) {
+                    opt.queue_depth = 1;
+                }
+                if (opt.block_size == 0) {
+                    opt.block_size = uring_file_options{}.block_size;
+                }
+                // A single read is at most INT_MAX bytes
+                opt.block_size =
+                    min(opt.block_size,
+                        static_cast<std::size_t>(
+                            (std::numeric_limits<int>::max)()));
+                blocks.resize(opt.queue_depth);
+                for (auto& b : blocks) {
+                    b.data.reset(new char[opt.block_size]);
+                }
+#if SCN_HAS_IO_URING
+                if (!opt.disable_io_uring && setup_ring()) {
+                    for (std::size_t i = 0; i < blocks.size(); ++i) {
+                        push(i, next_offset);
+                        next_offset += opt.block_size;
+                    }
+                    submit();
+                }
+#endif
+            }
+
+            uring_state(const uring_state&) = delete;
+            uring_state& operator=(const uring_state&) = delete;
+
+            ~uring_state()
+            {
+#if SCN_HAS_IO_URING
+                teardown_ring();
+#endif
+                if (owns_file) {
+                    close_native(file);
+                }
+            }
+
+            // Read the next block synchronously into blocks[0]
+            expected<span<const char>> read_fallback()
+            {
+                auto& b = blocks[0];
+#if SCN_POSIX
+                auto n = ::pread(file.handle, b.data.get(), opt.block_size,
+                                 static_cast<off_t>(next_offset));
+                while (n == -1 && errno == EINTR) {
+                    n = ::pread(file.handle, b.data.get(), opt.block_size,
+                                static_cast<off_t>(next_offset));
+                }
+#else
+                // No pread(): the file position is moved along
+                const auto n =
+                    read_native(file, b.data.get(), opt.block_size);
+#endif
+                if (n < 0) {
+                    return error(error::source_error, "read error");
+                }
+                if (n == 0) {
+                    eof = true;
+                }
+                next_offset += static_cast<std::uint64_t>(n);
+                return span<const char>{b.data.get(),
+                                        static_cast<std::size_t>(n)};
+            }
+
+#if SCN_HAS_IO_URING
+            bool setup_ring()
+            {
+                io_uring_params p;
+                std::memset(&p, 0, sizeof(p));
+                const auto entries = static_cast<unsigned>(blocks.size());
+                ring_fd = static_cast<int>(
+                    ::syscall(__NR_io_uring_setup, entries, &p));
+                if (ring_fd < 0) {
+                    ring_fd = -1;
+                    return false;
+                }
+
+                sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+                cq_ring_size =
+                    p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+                const bool single_mmap =
+                    (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (single_mmap) {
+                    sq_ring_size = cq_ring_size =
+                        (std::max)(sq_ring_size, cq_ring_size);
+                }
+
+                sq_ring = map_ring(sq_ring_size, IORING_OFF_SQ_RING);
+                if (!sq_ring) {
+                    teardown_ring();
+                    return false;
+                }
+                if (single_mmap) {
+                    cq_ring = sq_ring;
+                }
+                else {
+                    cq_ring = map_ring(cq_ring_size, IORING_OFF_CQ_RING);
+                    if (!cq_ring) {
+                        teardown_ring();
+                        return false;
+                    }
+                }
+                sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+                sqes = static_cast<io_uring_sqe*>(
+                    map_ring(sqes_size, IORING_OFF_SQES));
+                if (!sqes) {
+                    teardown_ring();
+                    return false;
+                }
+
+                auto sq = static_cast<char*>(sq_ring);
+                sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+                sq_mask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+                sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+                auto cq = static_cast<char*>(cq_ring);
+                cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+                cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+                cq_mask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+                cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+                // Registering the buffers saves mapping them on every read,
+                // but can fail because of RLIMIT_MEMLOCK
+                std::vector<iovec> iovecs(blocks.size());
+                for (std::size_t i = 0; i < blocks.size(); ++i) {
+                    iovecs[i].iov_base = blocks[i].data.get();
+                    iovecs[i].iov_len = opt.block_size;
+                }
+                fixed_buffers =
+                    ::syscall(__NR_io_uring_register, ring_fd,
+                              IORING_REGISTER_BUFFERS, iovecs.data(),
+                              static_cast<unsigned>(iovecs.size())) == 0;
+                return true;
+            }
+
+            void* map_ring(std::size_t size, unsigned long long off)
+            {
+                auto ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                                  MAP_SHARED | MAP_POPULATE, ring_fd,
+                                  static_cast<off_t>(off));
+                return ptr == MAP_FAILED ? nullptr : ptr;
+            }
+
+            void teardown_ring() noexcept
+            {
+                if (ring_fd == -1) {
+                    return;
+                }
+                // The kernel may still be writing into the blocks
+                while (in_flight != 0) {
+                    if (!wait_for_completion()) {
+                        break;
+                    }
+                }
+                if (sqes) {
+                    ::munmap(sqes, sqes_size);
+                }
+                if (cq_ring && cq_ring != sq_ring) {
+                    ::munmap(cq_ring, cq_ring_size);
+                }
+                if (sq_ring) {
+                    ::munmap(sq_ring, sq_ring_size);
+                }
+                sqes = nullptr;
+                sq_ring = cq_ring = nullptr;
+                ::close(ring_fd);
+                ring_fd = -1;
+            }
+
+            // Queue a read of the block at `offset` into blocks[i]
+            void push(std::size_t i, std::uint64_t offset) noexcept
+            {
+                auto& b = blocks[i];
+                b.offset = offset;
+                b.done = false;
+
+                const auto tail = *sq_tail;
+                const auto idx = tail & sq_mask;
+                auto& sqe = sqes[idx];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = static_cast<std::uint8_t>(
+                    fixed_buffers ? IORING_OP_READ_FIXED : IORING_OP_READ);
+                sqe.fd = file.handle;
+                sqe.addr = reinterpret_cast<std::uintptr_t>(b.data.get());
+                sqe.len = static_cast<std::uint32_t>(opt.block_size);
+                sqe.off = b.offset;
+                if (fixed_buffers) {
+                    sqe.buf_index = static_cast<std::uint16_t>(i);
+                }
+                sqe.user_data = i;
+                sq_array[idx] = idx;
+                __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+                ++to_submit;
+                ++in_flight;
+            }
+
+            // Hand the queued reads to the kernel
+            bool submit() noexcept
+            {
+                while (to_submit != 0) {
+                    const auto n = ::syscall(__NR_io_uring_enter, ring_fd,
+                                             to_submit, 0u, 0u, nullptr, 0);
+                    if (n < 0) {
+                        if (errno == EINTR || errno == EAGAIN) {
+                            continue;
+                        }
+                        return false;
+                    }
+                    to_submit -= static_cast<unsigned>(n);
+                }
+                return true;
+            }
+
+            // Mark finished reads as done
+            void reap() noexcept
+            {
+                auto h = *cq_head;
+                const auto t = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+                while (h != t) {
+                    const auto& cqe = cqes[h & cq_mask];
+                    auto& b = blocks[static_cast<std::size_t>(cqe.user_data)];
+                    b.result = cqe.res;
+                    b.done = true;
+                    --in_flight;
+                    ++h;
+                }
+                __atomic_store_n(cq_head, h, __ATOMIC_RELEASE);
+            }
+
+            bool wait_for_completion() noexcept
+            {
+                const auto n =
+                    ::syscall(__NR_io_uring_enter, ring_fd, to_submit, 1u,
+                              static_cast<unsigned>(IORING_ENTER_GETEVENTS),
+                              nullptr, 0);
+                if (n < 0 && errno != EINTR) {
+                    return false;
+                }
+                if (n > 0) {
+                    to_submit -= static_cast<unsigned>(n);
+                }
+                reap();
+                return true;
+            }
+
+            expected<span<const char>> acquire()
+            {
+                auto& b = blocks[head];
+                while (true) {
+                    reap();
+                    while (!b.done) {
+                        if (!wait_for_completion()) {
+                            return error(error::source_error,
+                                         "io_uring_enter failed");
+                        }
+                    }
+                    if (b.result != -EINTR && b.result != -EAGAIN) {
+                        break;
+                    }
+                    // Interrupted: read the same block again
+                    push(head, b.offset);
+                    submit();
+                }
+                if (b.result == -EINVAL || b.result == -EOPNOTSUPP) {
+                    // Operation not supported by this kernel:
+                    // continue with pread from this block on
+                    const auto offset = b.offset;
+                    teardown_ring();
+                    next_offset = offset;
+                    return read_fallback();
+                }
+                if (b.result < 0) {
+                    return error(error::source_error, "read error");
+                }
+                if (b.result == 0) {
+                    eof = true;
+                }
+                return span<const char>{b.data.get(),
+                                        static_cast<std::size_t>(b.result)};
+            }
+
+            void release() noexcept
+            {
+                auto& b = blocks[head];
+                const auto read_size = static_cast<std::size_t>(b.result);
+                if (read_size < opt.block_size) {
+                    // Short read: the reads after it assumed a full block,
+                    // so they're thrown away and queued again
+                    while (in_flight != 0) {
+                        if (!wait_for_completion()) {
+                            return;
+                        }
+                    }
+                    next_offset = b.offset + read_size;
+                    for (std::size_t i = 1; i <= blocks.size(); ++i) {
+                        push((head + i) % blocks.size(), next_offset);
+                        next_offset += opt.block_size;
+                    }
+                }
+                else {
+                    push(head, next_offset);
+                    next_offset += opt.block_size;
+                }
+                head = (head + 1) % blocks.size();
+                submit();
+            }
+
+            int ring_fd{-1};
+            void* sq_ring{nullptr};
+            void* cq_ring{nullptr};
+            std::size_t sq_ring_size{0};
+            std::size_t cq_ring_size{0};
+            io_uring_sqe* sqes{nullptr};
+            std::size_t sqes_size{0};
+            unsigned* sq_tail{nullptr};
+            unsigned* sq_array{nullptr};
+            unsigned sq_mask{0};
+            unsigned* cq_head{nullptr};
+            unsigned* cq_tail{nullptr};
+            unsigned cq_mask{0};
+            io_uring_cqe* cqes{nullptr};
+            unsigned to_submit{0};
+            std::size_t in_flight{0};
+            bool fixed_buffers{false};
+#endif
+
+            bool using_ring() const noexcept
+            {
+#if SCN_HAS_IO_URING
+                return ring_fd != -1;
+#else
+                return false;
+#endif
+            }
+
+            uring_file_options opt;
+            std::vector<block> blocks{};
+            // Index of the next block to be consumed
+            std::size_t head{0};
+            // Offset of the next read to be made
+            std::uint64_t next_offset{0};
+            bool eof{false};
+            native_file_handle file;
+            bool owns_file;
+        };
+
+        SCN_FUNC byte_uring_file::byte_uring_file(native_file_handle h,
+                                                  bool owns_handle,
+                                                  uring_file_options opt)
+            : m_state(new uring_state{h, owns_handle, opt})
+        {
+        }
+
+        SCN_FUNC bool byte_uring_file::uses_io_uring() const noexcept
+        {
+            return valid() && m_state->using_ring();
+        }
+
+        SCN_FUNC expected<span<const char>> byte_uring_file::_acquire_block()
+            const
+        {
+            SCN_EXPECT(valid());
+            // EOF is sticky
+            if (m_state->eof) {
+                return span<const char>{};
+            }
+#if SCN_HAS_IO_URING
+            if (m_state->using_ring()) {
+                return m_state->acquire();
+            }
+#endif
+            return m_state->read_fallback();
+        }
+
+        SCN_FUNC void byte_uring_file::_release_block() const noexcept
+        {
+            SCN_EXPECT(valid());
+#if SCN_HAS_IO_URING
+            if (m_state->using_ring()) {
+                m_state->release();
+            }
+#endif
+        }
+
+        SCN_FUNC void byte_uring_file::_destruct() noexcept
+        {
+            delete m_state;
+            m_state = nullptr;
+        }
+    }  // namespace detail
 
     SCN_END_NAMESPACE
 }  // namespace scn
@@ -43,8 +43,10 @@ namespace scn {
 
             string_type truename{};
             string_type falsename{};
+            std::string grouping{};
             char_type decimal_point{};
             char_type thousands_separator{};
+            bool ascii_digits{true};
         };
 
         template <typename CharT>
@@ -92,6 +94,19 @@ namespace scn {
             data.falsename = facet.falsename();
             data.decimal_point = facet.decimal_point();
             data.thousands_separator = facet.thousands_sep();
+            data.grouping = facet.grouping();
+
+            // Stream extraction recognizes digits by comparing to
+            // widened "0123456789abcdefABCDEF"
+            const auto& ctype =
+                std::use_facet<std::ctype<CharT>>(to_locale(*this));
+            data.ascii_digits = true;
+            for (auto ch : string_view{"0123456789abcdefABCDEF"}) {
+                if (ctype.widen(ch) != ascii_widen<CharT>(ch)) {
+                    data.ascii_digits = false;
+                    break;
+                }
+            }
         }
 
         template <typename CharT>
@@ -175,6 +190,19 @@ namespace scn {
             return static_cast<locale_data<CharT>*>(m_data)
                 ->thousands_separator;
         }
+        template <typename CharT>
+        string_view basic_custom_locale_ref<CharT>::grouping() const
+        {
+            const auto& str =
+                static_cast<locale_data<CharT>*>(m_data)->grouping;
+            return {str.data(), str.size()};
+        }
+        template <typename CharT>
+        bool basic_custom_locale_ref<CharT>::has_ascii_digits() const
+        {
+            return static_cast<locale_data<CharT>*>(m_data)->ascii_digits;
+        }
+
         template <typename CharT>
         auto basic_custom_locale_ref<CharT>::do_truename() const
             -> string_view_type
@@ -24,6 +24,17 @@
 
 #include <cerrno>
 #include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <cwchar>
+#include <limits>
+
+#if SCN_POSIX
+#include <locale.h>
+#if SCN_APPLE
+#include <xlocale.h>
+#endif
+#endif
 
 #if SCN_HAS_FLOAT_CHARCONV
 #include <charconv>
@@ -55,22 +66,180 @@ namespace scn {
     SCN_BEGIN_NAMESPACE
 
     namespace read_float {
-        static bool is_hexfloat(const char* str, std::size_t len) noexcept
+        template <typename CharT>
+        static bool is_hexfloat(const CharT* str, std::size_t len) noexcept
         {
+            if (len != 0 && (str[0] == CharT('-') || str[0] == CharT('+'))) {
+                ++str;
+                --len;
+            }
             if (len < 3) {
                 return false;
             }
-            return str[0] == '0' && (str[1] == 'x' || str[1] == 'X');
+            return str[0] == CharT('0') &&
+                   (str[1] == CharT('x') || str[1] == CharT('X'));
         }
-        static bool is_hexfloat(const wchar_t* str, std::size_t len) noexcept
+
+        static bool is_ascii(wchar_t ch) noexcept
         {
-            if (len < 3) {
-                return false;
-            }
-            return str[0] == L'0' && (str[1] == L'x' || str[1] == L'X');
+            // wchar_t may be signed: negative values wrap to large ones
+            return static_cast<unsigned long>(ch) <= 0x7f;
         }
 
         namespace cstd {
+            // strtod and friends read the decimal point from the C locale,
+            // so they're called with a "C" LC_NUMERIC in effect.
+            // The locale is created once and shared between threads:
+            // it's deliberately never freed, so that it outlives every
+            // thread that might still be parsing.
+#if SCN_POSIX
+            // uselocale() only affects the calling thread
+            static locale_t c_locale() noexcept
+            {
+                static const locale_t loc =
+                    newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+                return loc;
+            }
+
+            class c_locale_scope {
+            public:
+                c_locale_scope() noexcept
+                {
+                    auto loc = c_locale();
+                    if (loc != static_cast<locale_t>(0)) {
+                        m_prev = uselocale(loc);
+                    }
+                }
+                c_locale_scope(const c_locale_scope&) = delete;
+                c_locale_scope& operator=(const c_locale_scope&) = delete;
+                ~c_locale_scope()
+                {
+                    if (m_prev != static_cast<locale_t>(0)) {
+                        uselocale(m_prev);
+                    }
+                }
+
+            private:
+                locale_t m_prev{static_cast<locale_t>(0)};
+            };
+
+            static float strtof_c(const char* str, char** end)
+            {
+                return std::strtof(str, end);
+            }
+            static double strtod_c(const char* str, char** end)
+            {
+                return std::strtod(str, end);
+            }
+            static long double strtold_c(const char* str, char** end)
+            {
+                return std::strtold(str, end);
+            }
+            static float wcstof_c(const wchar_t* str, wchar_t** end)
+            {
+                return std::wcstof(str, end);
+            }
+            static double wcstod_c(const wchar_t* str, wchar_t** end)
+            {
+                return std::wcstod(str, end);
+            }
+            static long double wcstold_c(const wchar_t* str, wchar_t** end)
+            {
+                return std::wcstold(str, end);
+            }
+#elif SCN_WINDOWS
+            // The _l variants take the locale as an argument,
+            // no global or per-thread state is touched
+            static _locale_t c_locale() noexcept
+            {
+                static const _locale_t loc = _create_locale(LC_NUMERIC, "C");
+                return loc;
+            }
+
+            struct c_locale_scope {
+                c_locale_scope() noexcept = default;
+            };
+
+            static float strtof_c(const char* str, char** end)
+            {
+                return _strtof_l(str, end, c_locale());
+            }
+            static double strtod_c(const char* str, char** end)
+            {
+                return _strtod_l(str, end, c_locale());
+            }
+            static long double strtold_c(const char* str, char** end)
+            {
+                return _strtold_l(str, end, c_locale());
+            }
+            static float wcstof_c(const wchar_t* str, wchar_t** end)
+            {
+                return _wcstof_l(str, end, c_locale());
+            }
+            static double wcstod_c(const wchar_t* str, wchar_t** end)
+            {
+                return _wcstod_l(str, end, c_locale());
+            }
+            static long double wcstold_c(const wchar_t* str, wchar_t** end)
+            {
+                return _wcstold_l(str, end, c_locale());
+            }
+#else
+            // No per-thread locales available:
+            // fall back to switching the global locale,
+            // which isn't safe if other threads use it concurrently
+            class c_locale_scope {
+            public:
+                c_locale_scope() noexcept
+                {
+                    // Get current C locale
+                    const auto loc = std::setlocale(LC_NUMERIC, nullptr);
+                    // For whatever reason, this cannot be stored in the heap
+                    // if setlocale hasn't been called before, or msan errors
+                    // with 'use-of-unitialized-value' when resetting the
+                    // locale back. The content of loc may not be static, so
+                    // we need to save it ourselves
+                    std::strncpy(m_prev, loc, sizeof(m_prev) - 1);
+
+                    std::setlocale(LC_NUMERIC, "C");
+                }
+                c_locale_scope(const c_locale_scope&) = delete;
+                c_locale_scope& operator=(const c_locale_scope&) = delete;
+                ~c_locale_scope()
+                {
+                    std::setlocale(LC_NUMERIC, m_prev);
+                }
+
+            private:
+                char m_prev[64] = {0};
+            };
+
+            static float strtof_c(const char* str, char** end)
+            {
+                return std::strtof(str, end);
+            }
+            static double strtod_c(const char* str, char** end)
+            {
+                return std::strtod(str, end);
+            }
+            static long double strtold_c(const char* str, char** end)
+            {
+                return std::strtold(str, end);
+            }
+            static float wcstof_c(const wchar_t* str, wchar_t** end)
+            {
+                return std::wcstof(str, end);
+            }
+            static double wcstod_c(const wchar_t* str, wchar_t** end)
+            {
+                return std::wcstod(str, end);
+            }
+            static long double wcstold_c(const wchar_t* str, wchar_t** end)
+            {
+                return std::wcstold(str, end);
+            }
+#endif
+
 #if SCN_GCC >= SCN_COMPILER(7, 0, 0)
             SCN_GCC_PUSH
             SCN_GCC_IGNORE("-Wnoexcept-type")
@@ -78,29 +247,28 @@ namespace scn {
             template <typename T, typename CharT, typename F>
             expected<T> impl(F&& f_strtod,
                              T huge_value,
-                             const CharT* str,
+                             const CharT* first,
+                             size_t len,
                              size_t& chars,
                              uint8_t options)
             {
-                // Get current C locale
-                const auto loc = std::setlocale(LC_NUMERIC, nullptr);
-                // For whatever reason, this cannot be stored in the heap if
-                // setlocale hasn't been called before, or msan errors with
-                // 'use-of-unitialized-value' when resetting the locale back.
-                // POSIX specifies that the content of loc may not be static, so
-                // we need to save it ourselves
-                char locbuf[64] = {0};
-                std::strcpy(locbuf, loc);
-
-                std::setlocale(LC_NUMERIC, "C");
+                // strtod needs a NUL-terminated string:
+                // copy the token, on the stack unless it's unusually long
+                detail::small_vector<CharT, 64> buf(len + 1);
+                std::copy(first, first + len, buf.data());
+                buf[len] = CharT{0};
+                const CharT* str = buf.data();
 
                 CharT* end{};
-                errno = 0;
-                T f = f_strtod(str, &end);
+                T f{};
+                int err{};
+                {
+                    c_locale_scope scope{};
+                    errno = 0;
+                    f = f_strtod(str, &end);
+                    err = errno;
+                }
                 chars = static_cast<size_t>(end - str);
-                auto err = errno;
-                // Reset locale
-                std::setlocale(LC_NUMERIC, locbuf);
                 errno = 0;
 
                 SCN_GCC_COMPAT_PUSH
@@ -126,7 +294,7 @@ namespace scn {
                     // Subnormals cause ERANGE but a value is still returned
                 }
 
-                if (is_hexfloat(str, detail::strlen(str)) &&
+                if (is_hexfloat(str, len) &&
                     (options & detail::float_scanner<T>::allow_hex) == 0) {
                     return error(error::invalid_scanned_value,
                                  "Hexfloats not allowed by the format string");
@@ -145,89 +313,343 @@ namespace scn {
             template <>
             struct read<char, float> {
                 static expected<float> get(const char* str,
+                                           size_t len,
                                            size_t& chars,
                                            uint8_t options)
                 {
-                    return impl<float>(strtof, HUGE_VALF, str, chars, options);
+                    return impl<float>(strtof_c, HUGE_VALF, str, len, chars,
+                                       options);
                 }
             };
 
             template <>
             struct read<char, double> {
                 static expected<double> get(const char* str,
+                                            size_t len,
                                             size_t& chars,
                                             uint8_t options)
                 {
-                    return impl<double>(strtod, HUGE_VAL, str, chars, options);
+                    return impl<double>(strtod_c, HUGE_VAL, str, len, chars,
+                                        options);
                 }
             };
 
             template <>
             struct read<char, long double> {
                 static expected<long double> get(const char* str,
+                                                 size_t len,
                                                  size_t& chars,
                                                  uint8_t options)
                 {
-                    return impl<long double>(strtold, HUGE_VALL, str, chars,
-                                             options);
+                    return impl<long double>(strtold_c, HUGE_VALL, str, len,
+                                             chars, options);
                 }
             };
 
             template <>
             struct read<wchar_t, float> {
                 static expected<float> get(const wchar_t* str,
+                                           size_t len,
                                            size_t& chars,
                                            uint8_t options)
                 {
-                    return impl<float>(wcstof, HUGE_VALF, str, chars, options);
+                    return impl<float>(wcstof_c, HUGE_VALF, str, len, chars,
+                                       options);
                 }
             };
             template <>
             struct read<wchar_t, double> {
                 static expected<double> get(const wchar_t* str,
+                                            size_t len,
                                             size_t& chars,
                                             uint8_t options)
                 {
-                    return impl<double>(wcstod, HUGE_VAL, str, chars, options);
+                    return impl<double>(wcstod_c, HUGE_VAL, str, len, chars,
+                                        options);
                 }
             };
             template <>
             struct read<wchar_t, long double> {
                 static expected<long double> get(const wchar_t* str,
+                                                 size_t len,
                                                  size_t& chars,
                                                  uint8_t options)
                 {
-                    return impl<long double>(wcstold, HUGE_VALL, str, chars,
-                                             options);
+                    return impl<long double>(wcstold_c, HUGE_VALL, str, len,
+                                             chars, options);
                 }
             };
         }  // namespace cstd
 
+        namespace hexfloat {
+            template <typename CharT>
+            static int digit_value(CharT ch) noexcept
+            {
+                if (ch >= CharT('0') && ch <= CharT('9')) {
+                    return static_cast<int>(ch - CharT('0'));
+                }
+                if (ch >= CharT('a') && ch <= CharT('f')) {
+                    return static_cast<int>(ch - CharT('a')) + 10;
+                }
+                if (ch >= CharT('A') && ch <= CharT('F')) {
+                    return static_cast<int>(ch - CharT('A')) + 10;
+                }
+                return -1;
+            }
+
+            // The significand of T has to fit in the 64-bit accumulator
+            template <typename T>
+            struct is_supported
+                : std::integral_constant<
+                      bool,
+                      std::numeric_limits<T>::radix == 2 &&
+                          std::numeric_limits<T>::digits <= 64> {
+            };
+
+            // Parses [-+]0x<hex digits>[.<hex digits>][p[-+]<digits>],
+            // correctly rounded to nearest, ties to even.
+            // The first 16 significant hex digits are kept in a 64-bit
+            // significand, the 17th separately, and the rest only as a
+            // sticky bit: that's all the information rounding to
+            // at most 64 bits needs.
+            template <typename T, typename CharT>
+            expected<T> parse(const CharT* str, size_t len, size_t& chars)
+            {
+                const CharT* it = str;
+                const CharT* const end = str + len;
+
+                bool minus = false;
+                if (*it == CharT('-') || *it == CharT('+')) {
+                    minus = *it == CharT('-');
+                    ++it;
+                }
+                const CharT* const zero = it;
+                it += 2;  // "0x", checked by is_hexfloat
+
+                uint64_t mant = 0;
+                int ndigits = 0;  // significant digits seen, up to 17
+                int extra = 0;    // the 17th significant digit
+                bool sticky = false;
+                long exp2 = 0;
+                bool any_digits = false;
+
+                auto push_digit = [&](int d, bool fraction) {
+                    any_digits = true;
+                    if (mant == 0 && d == 0) {
+                        // Leading zero
+                        if (fraction) {
+                            exp2 -= 4;
+                        }
+                        return;
+                    }
+                    if (ndigits < 16) {
+                        mant = (mant << 4) | static_cast<uint64_t>(d);
+                        ++ndigits;
+                        if (fraction) {
+                            exp2 -= 4;
+                        }
+                        return;
+                    }
+                    if (ndigits == 16) {
+                        extra = d;
+                        ++ndigits;
+                    }
+                    else {
+                        sticky = sticky || d != 0;
+                    }
+                    if (!fraction) {
+                        exp2 += 4;
+                    }
+                };
+
+                for (; it != end; ++it) {
+                    const auto d = digit_value(*it);
+                    if (d < 0) {
+                        break;
+                    }
+                    push_digit(d, false);
+                }
+                if (it != end && *it == CharT('.')) {
+                    ++it;
+                    for (; it != end; ++it) {
+                        const auto d = digit_value(*it);
+                        if (d < 0) {
+                            break;
+                        }
+                        push_digit(d, true);
+                    }
+                }
+                if (!any_digits) {
+                    // Like strtod: only the leading "0" is a number
+                    chars = static_cast<size_t>(zero + 1 - str);
+                    return minus ? -T{0} : T{0};
+                }
+
+                // Binary exponent, only consumed if well-formed
+                if (it != end && (*it == CharT('p') || *it == CharT('P'))) {
+                    auto exp_it = it + 1;
+                    bool exp_minus = false;
+                    if (exp_it != end &&
+                        (*exp_it == CharT('-') || *exp_it == CharT('+'))) {
+                        exp_minus = *exp_it == CharT('-');
+                        ++exp_it;
+                    }
+                    if (exp_it != end && *exp_it >= CharT('0') &&
+                        *exp_it <= CharT('9')) {
+                        // Saturate: anything this large over- or underflows
+                        const long exp_limit = 1L << 24;
+                        long exp = 0;
+                        for (; exp_it != end && *exp_it >= CharT('0') &&
+                               *exp_it <= CharT('9');
+                             ++exp_it) {
+                            if (exp < exp_limit) {
+                                exp = exp * 10 +
+                                      static_cast<long>(*exp_it - CharT('0'));
+                            }
+                        }
+                        exp2 += exp_minus ? -exp : exp;
+                        it = exp_it;
+                    }
+                }
+                chars = static_cast<size_t>(it - str);
+
+                if (mant == 0) {
+                    return minus ? -T{0} : T{0};
+                }
+
+                // Normalize, so that the value is mant * 2^exp2,
+                // with the most significant bit of mant set
+                const auto lz = ::fast_float::leading_zeroes(mant);
+                mant <<= lz;
+                exp2 -= lz;
+                bool round_bit = false;
+                if (ndigits > 16) {
+                    // The leading digit is nonzero, so lz < 4:
+                    // shift in the top bits of the 17th digit
+                    const int rest = 4 - lz;
+                    if (lz != 0) {
+                        mant |= static_cast<uint64_t>(extra) >> rest;
+                    }
+                    round_bit = ((extra >> (rest - 1)) & 1) != 0;
+                    sticky = sticky || (extra & ((1 << (rest - 1)) - 1)) != 0;
+                }
+
+                using limits = std::numeric_limits<T>;
+                const long emin = limits::min_exponent - 1;
+                const long emax = limits::max_exponent - 1;
+
+                // Value is in [2^e, 2^(e+1))
+                long e = exp2 + 63;
+                if (e > emax) {
+                    return error(error::value_out_of_range,
+                                 "Floating-point value out of range: overflow");
+                }
+                // Significand bits to keep, fewer for subnormals
+                long keep = limits::digits;
+                if (e < emin) {
+                    keep -= emin - e;
+                }
+
+                uint64_t q = 0;
+                bool half = false;
+                bool lower = true;
+                if (keep == 0) {
+                    half = true;
+                    lower = (mant << 1) != 0 || round_bit || sticky;
+                }
+                else if (keep == 64) {
+                    q = mant;
+                    half = round_bit;
+                    lower = sticky;
+                }
+                else if (keep > 0) {
+                    const auto shift = static_cast<int>(64 - keep);
+                    q = mant >> shift;
+                    half = ((mant >> (shift - 1)) & 1) != 0;
+                    lower =
+                        (mant & ((uint64_t{1} << (shift - 1)) - 1)) != 0 ||
+                        round_bit || sticky;
+                }
+                if (half && (lower || (q & 1) != 0)) {
+                    ++q;
+                    if (q == 0) {
+                        // Carried out of all 64 bits
+                        q = uint64_t{1} << 63;
+                        ++e;
+                    }
+                }
+
+                if (q == 0) {
+                    return error(
+                        error::value_out_of_range,
+                        "Floating-point value out of range: underflow");
+                }
+                if (e == emax && keep < 64 && (q >> keep) != 0) {
+                    // Rounded up to 2^(emax+1)
+                    return error(error::value_out_of_range,
+                                 "Floating-point value out of range: overflow");
+                }
+                if (e > emax) {
+                    return error(error::value_out_of_range,
+                                 "Floating-point value out of range: overflow");
+                }
+
+                // q has at most limits::digits bits (or is a power of two),
+                // so both the conversion and the scaling are exact
+                const T value = std::ldexp(static_cast<T>(q),
+                                           static_cast<int>(e - keep + 1));
+                return minus ? -value : value;
+            }
+
+            template <typename T, typename CharT>
+            expected<T> read(const CharT* str,
+                             size_t len,
+                             size_t& chars,
+                             uint8_t options,
+                             std::true_type)
+            {
+                SCN_UNUSED(options);
+                return parse<T>(str, len, chars);
+            }
+            template <typename T, typename CharT>
+            expected<T> read(const CharT* str,
+                             size_t len,
+                             size_t& chars,
+                             uint8_t options,
+                             std::false_type)
+            {
+                // Wider significand (e.g. binary128 long double)
+                return cstd::read<CharT, T>::get(str, len, chars, options);
+            }
+            template <typename T, typename CharT>
+            expected<T> read(const CharT* str,
+                             size_t len,
+                             size_t& chars,
+                             uint8_t options)
+            {
+                return read<T>(str, len, chars, options,
+                               is_supported<T>{});
+            }
+        }  // namespace hexfloat
+
         namespace from_chars {
 #if SCN_HAS_FLOAT_CHARCONV
             template <typename T>
             struct read {
                 static expected<T> get(const char* str,
+                                       size_t len,
                                        size_t& chars,
                                        uint8_t options)
                 {
-                    const auto len = std::strlen(str);
+                    // Hexfloats are handled by read_float::hexfloat
                     std::chars_format flags{};
-                    if (((options & detail::float_scanner<T>::allow_hex) !=
-                         0) &&
-                        is_hexfloat(str, len)) {
-                        str += 2;
-                        flags = std::chars_format::hex;
+                    if ((options & detail::float_scanner<T>::allow_fixed) !=
+                        0) {
+                        flags |= std::chars_format::fixed;
                     }
-                    else {
-                        if ((options & detail::float_scanner<T>::allow_fixed) !=
-                            0) {
-                            flags |= std::chars_format::fixed;
-                        }
-                        if ((options &
-                             detail::float_scanner<T>::allow_scientific) != 0) {
-                            flags |= std::chars_format::scientific;
-                        }
+                    if ((options &
+                         detail::float_scanner<T>::allow_scientific) != 0) {
+                        flags |= std::chars_format::scientific;
                     }
                     if (flags == static_cast<std::chars_format>(0)) {
                         return error{error::invalid_scanned_value,
@@ -244,7 +666,8 @@ namespace scn {
                     if (result.ec == std::errc::result_out_of_range) {
                         // Out of range, may be subnormal -> fall back to strtod
                         // On gcc std::from_chars doesn't parse subnormals
-                        return cstd::read<char, T>::get(str, chars, options);
+                        return cstd::read<char, T>::get(str, len, chars,
+                                                        options);
                     }
                     chars = static_cast<size_t>(result.ptr - str);
                     return value;
@@ -254,11 +677,13 @@ namespace scn {
             template <typename T>
             struct read {
                 static expected<T> get(const char* str,
+                                       size_t len,
                                        size_t& chars,
                                        uint8_t options)
                 {
                     // Fall straight back to strtod
-                    return cstd::read<char, T>::get(str, chars, options);
+                    return cstd::read<char, T>::get(str, len, chars,
+                                                    options);
                 }
             };
 #endif
@@ -266,19 +691,10 @@ namespace scn {
 
         namespace fast_float {
             template <typename T>
-            expected<T> impl(const char* str,
-                             size_t& chars,
-                             uint8_t options,
-                             char locale_decimal_point)
+            ::fast_float::parse_options make_parse_options(
+                uint8_t options,
+                char locale_decimal_point)
             {
-                const auto len = std::strlen(str);
-                if (((options & detail::float_scanner<T>::allow_hex) != 0) &&
-                    is_hexfloat(str, len)) {
-                    // fast_float doesn't support hexfloats
-                    return from_chars::read<T>::get(str, chars, options);
-                }
-
-                T value{};
                 ::fast_float::parse_options flags{};
                 if ((options & detail::float_scanner<T>::allow_fixed) != 0) {
                     flags.format = ::fast_float::fixed;
@@ -291,6 +707,19 @@ namespace scn {
                 if ((options & detail::float_scanner<T>::localized) != 0) {
                     flags.decimal_point = locale_decimal_point;
                 }
+                return flags;
+            }
+
+            template <typename T>
+            expected<T> impl(const char* str,
+                             size_t len,
+                             size_t& chars,
+                             uint8_t options,
+                             char locale_decimal_point)
+            {
+                T value{};
+                const auto flags =
+                    make_parse_options<T>(options, locale_decimal_point);
 
                 const auto result = ::fast_float::from_chars_advanced(
                     str, str + len, value, flags);
@@ -306,7 +735,8 @@ namespace scn {
                     if (!(len >= 3 && (str[0] == 'i' || str[0] == 'I'))) {
                         // Input was not actually infinity ->
                         // invalid result, fall back to from_chars
-                        return from_chars::read<T>::get(str, chars, options);
+                        return from_chars::read<T>::get(str, len, chars,
+                                                        options);
                     }
                 }
                 chars = static_cast<size_t>(result.ptr - str);
@@ -319,36 +749,144 @@ namespace scn {
             template <>
             struct read<float> {
                 static expected<float> get(const char* str,
+                                           size_t len,
                                            size_t& chars,
                                            uint8_t options,
                                            char locale_decimal_point)
                 {
-                    return impl<float>(str, chars, options,
+                    return impl<float>(str, len, chars, options,
                                        locale_decimal_point);
                 }
             };
             template <>
             struct read<double> {
                 static expected<double> get(const char* str,
+                                            size_t len,
                                             size_t& chars,
                                             uint8_t options,
                                             char locale_decimal_points)
                 {
-                    return impl<double>(str, chars, options,
+                    return impl<double>(str, len, chars, options,
                                         locale_decimal_points);
                 }
             };
+
+            // fast_float doesn't support long double.
+            // Where long double is just double, parse a double.
+            // Otherwise, use fast_float's tokenizer, and Clinger's fast path
+            // if both the significand and the power of ten are exact in
+            // long double: a single multiplication or division of two
+            // exact values is then correctly rounded.
+            // Anything else (long significands, large exponents,
+            // inf and nan) goes to strtold.
+            namespace long_double {
+                using limits = std::numeric_limits<long double>;
+
+                // Largest n for which 10^n == 2^n * 5^n is exact,
+                // i.e. 5^n fits in the significand, or -1 if unknown.
+                // x87 precision control is lowered to double on Windows
+                // and FreeBSD, so don't trust the hardware there.
+#if SCN_WINDOWS || defined(__FreeBSD__)
+                constexpr int max_exact_pow10 =
+                    limits::digits == 113 ? 48 : -1;
+#else
+                constexpr int max_exact_pow10 =
+                    limits::digits == 64 ? 27
+                                         : (limits::digits == 113 ? 48 : -1);
+#endif
+
+                inline long double exact_pow10(int n) noexcept
+                {
+                    static const long double table[] = {
+                        1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,
+                        1e7L,  1e8L,  1e9L,  1e10L, 1e11L, 1e12L, 1e13L,
+                        1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L, 1e20L,
+                        1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L,
+                        1e28L, 1e29L, 1e30L, 1e31L, 1e32L, 1e33L, 1e34L,
+                        1e35L, 1e36L, 1e37L, 1e38L, 1e39L, 1e40L, 1e41L,
+                        1e42L, 1e43L, 1e44L, 1e45L, 1e46L, 1e47L, 1e48L};
+                    SCN_EXPECT(n >= 0 && n <= max_exact_pow10);
+                    return table[n];
+                }
+
+                inline expected<long double> clinger(const char* str,
+                                                     size_t len,
+                                                     size_t& chars,
+                                                     uint8_t options,
+                                                     char decimal_point)
+                {
+                    const auto pns = ::fast_float::parse_number_string(
+                        str, str + len,
+                        make_parse_options<long double>(options,
+                                                        decimal_point));
+                    if (!pns.valid || pns.too_many_digits ||
+                        pns.exponent < -max_exact_pow10 ||
+                        pns.exponent > max_exact_pow10 ||
+                        (limits::digits < 64 &&
+                         (pns.mantissa >> (limits::digits % 64)) != 0)) {
+                        return cstd::read<char, long double>::get(
+                            str, len, chars, options);
+                    }
+
+                    auto value = static_cast<long double>(pns.mantissa);
+                    const auto exp = static_cast<int>(pns.exponent);
+                    if (exp < 0) {
+                        value = value / exact_pow10(-exp);
+                    }
+                    else {
+                        value = value * exact_pow10(exp);
+                    }
+                    chars = static_cast<size_t>(pns.lastmatch - str);
+                    return pns.negative ? -value : value;
+                }
+
+                inline expected<long double> read(const char* str,
+                                                  size_t len,
+                                                  size_t& chars,
+                                                  uint8_t options,
+                                                  char decimal_point,
+                                                  std::true_type)
+                {
+                    // Same format as double
+                    auto ret =
+                        impl<double>(str, len, chars, options, decimal_point);
+                    if (!ret) {
+                        return ret.error();
+                    }
+                    return static_cast<long double>(ret.value());
+                }
+                inline expected<long double> read(const char* str,
+                                                  size_t len,
+                                                  size_t& chars,
+                                                  uint8_t options,
+                                                  char decimal_point,
+                                                  std::false_type)
+                {
+                    if (max_exact_pow10 < 0) {
+                        return cstd::read<char, long double>::get(
+                            str, len, chars, options);
+                    }
+                    return clinger(str, len, chars, options, decimal_point);
+                }
+            }  // namespace long_double
+
             template <>
             struct read<long double> {
                 static expected<long double> get(const char* str,
+                                                 size_t len,
                                                  size_t& chars,
                                                  uint8_t options,
-                                                 char)
+                                                 char locale_decimal_point)
                 {
-                    // Fallback to strtod
-                    // fast_float doesn't support long double
-                    return cstd::read<char, long double>::get(str, chars,
-                                                              options);
+                    using same_as_double = std::integral_constant<
+                        bool,
+                        long_double::limits::digits ==
+                                std::numeric_limits<double>::digits &&
+                            long_double::limits::max_exponent ==
+                                std::numeric_limits<double>::max_exponent>;
+                    return long_double::read(str, len, chars, options,
+                                             locale_decimal_point,
+                                             same_as_double{});
                 }
             };
         }  // namespace fast_float
@@ -359,27 +897,77 @@ namespace scn {
         template <typename T>
         struct read<char, T> {
             static expected<T> get(const char* str,
+                                   size_t len,
                                    size_t& chars,
                                    uint8_t options,
                                    char locale_decimal_points)
             {
+                if ((options & detail::float_scanner<T>::allow_hex) != 0 &&
+                    is_hexfloat(str, len)) {
+                    return hexfloat::read<T>(str, len, chars, options);
+                }
                 // char -> default to fast_float,
                 // fallback to strtod if necessary
                 return read_float::fast_float::read<T>::get(
-                    str, chars, options, locale_decimal_points);
+                    str, len, chars, options, locale_decimal_points);
             }
         };
         template <typename T>
         struct read<wchar_t, T> {
             static expected<T> get(const wchar_t* str,
+                                   size_t len,
                                    size_t& chars,
                                    uint8_t options,
-                                   wchar_t)
+                                   wchar_t locale_decimal_point)
             {
-                // wchar_t -> straight to strtod
-                return read_float::cstd::read<wchar_t, T>::get(str, chars,
-                                                               options);
+                if ((options & detail::float_scanner<T>::allow_hex) != 0 &&
+                    is_hexfloat(str, len)) {
+                    return hexfloat::read<T>(str, len, chars, options);
+                }
+
+                const bool localized =
+                    (options & detail::float_scanner<T>::localized) != 0;
+                if (localized && !is_ascii(locale_decimal_point)) {
+                    // Can't be narrowed -> straight to strtod
+                    return read_float::cstd::read<wchar_t, T>::get(
+                        str, len, chars, options);
+                }
+
+                // wcstod accepts a leading '+', which fast_float doesn't:
+                // skip it, unless it's followed by another sign
+                size_t plus = 0;
+                if (len > 1 && str[0] == L'+' && str[1] != L'+' &&
+                    str[1] != L'-') {
+                    plus = 1;
+                }
+
+                // A valid float is all ASCII: narrow the ASCII prefix of
+                // the token, and parse that as char, with fast_float.
+                // Every wide character maps to one narrow one,
+                // so the count of characters read carries over as is.
+                size_t ascii_len = 0;
+                while (plus + ascii_len != len &&
+                       is_ascii(str[plus + ascii_len])) {
+                    ++ascii_len;
+                }
+                if (ascii_len == 0) {
+                    return error(error::invalid_scanned_value,
+                                 "Expected a floating-point value");
+                }
+                detail::small_vector<char, 64> buf(ascii_len);
+                for (size_t i = 0; i != ascii_len; ++i) {
+                    buf[i] = static_cast<char>(str[plus + i]);
+                }
+                auto ret = read<char, T>::get(
+                    buf.data(), ascii_len, chars, options,
+                    static_cast<char>(localized ? locale_decimal_point
+                                                : L'.'));
+                if (ret) {
+                    chars += plus;
+                }
+                return ret;
             }
+
         };
     }  // namespace read_float
 
@@ -388,42 +976,57 @@ namespace scn {
         template <typename CharT>
         expected<T> float_scanner<T>::_read_float_impl(
             const CharT* str,
+            size_t len,
             size_t& chars,
             CharT locale_decimal_point)
         {
             // Parsing algorithm to use:
+            // If a hexfloat (and allowed) -> read_float::hexfloat,
+            //   strtod only if the significand is wider than 64 bits
             // If CharT == wchar_t -> strtod
             // If CharT == char:
             //   1. fast_float
-            //      fallback if a hex float, or incorrectly parsed an inf
+            //      fallback if incorrectly parsed an inf
             //      (very large or small value)
             //   2. std::from_chars
             //      fallback if not available (C++17) or float is subnormal
             //   3. std::strtod
-            return read_float::read<CharT, T>::get(str, chars, format_options,
-                                                   locale_decimal_point);
+            // Only strtod needs a NUL-terminated copy of [str, str + len),
+            // the others parse the range in place
+            return read_float::read<CharT, T>::get(
+                str, len, chars, format_options, locale_decimal_point);
         }
 
 #if SCN_INCLUDE_SOURCE_DEFINITIONS
 
-        template expected<float>
-        float_scanner<float>::_read_float_impl(const char*, size_t&, char);
-        template expected<double>
-        float_scanner<double>::_read_float_impl(const char*, size_t&, char);
+        template expected<float> float_scanner<float>::_read_float_impl(
+            const char*,
+            size_t,
+            size_t&,
+            char);
+        template expected<double> float_scanner<double>::_read_float_impl(
+            const char*,
+            size_t,
+            size_t&,
+            char);
         template expected<long double>
         float_scanner<long double>::_read_float_impl(const char*,
+                                                     size_t,
                                                      size_t&,
                                                      char);
         template expected<float> float_scanner<float>::_read_float_impl(
             const wchar_t*,
+            size_t,
             size_t&,
             wchar_t);
         template expected<double> float_scanner<double>::_read_float_impl(
             const wchar_t*,
+            size_t,
             size_t&,
             wchar_t);
         template expected<long double>
         float_scanner<long double>::_read_float_impl(const wchar_t*,
+                                                     size_t,
                                                      size_t&,
                                                      wchar_t);
 #endif
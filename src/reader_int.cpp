@@ -22,6 +22,10 @@
 #include <scn/detail/args.h>
 #include <scn/reader/int.h>
 
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
 namespace scn {
     SCN_BEGIN_NAMESPACE
 
@@ -63,6 +67,282 @@ namespace scn {
             SCN_GCC_POP
         }
 
+        // Eight characters, the first one in the lowest byte
+        SCN_NODISCARD static std::uint64_t _read_eight_chars(const char* p)
+        {
+            std::uint64_t v{};
+#if SCN_IS_BIG_ENDIAN
+            for (int i = 0; i < 8; ++i) {
+                v |= static_cast<std::uint64_t>(
+                         static_cast<unsigned char>(p[i]))
+                     << (8 * i);
+            }
+#else
+            std::memcpy(&v, p, 8);
+#endif
+            return v;
+        }
+
+        // Whether all eight characters in `v` are in ['0', '9']
+        SCN_NODISCARD static bool _is_eight_digits(std::uint64_t v)
+        {
+            return ((v & 0xf0f0f0f0f0f0f0f0u) |
+                    (((v + 0x0606060606060606u) & 0xf0f0f0f0f0f0f0f0u) >>
+                     4u)) == 0x3333333333333333u;
+        }
+
+        // Value of eight decimal digits, the first one in the lowest byte.
+        // Adjacent digits are combined pairwise with multiply-adds,
+        // in three steps: 8 -> 4 -> 2 -> 1.
+        SCN_NODISCARD static std::uint32_t _parse_eight_digits(std::uint64_t v)
+        {
+            constexpr std::uint64_t mask = 0x000000ff000000ffu;
+            // 100 + (1000000 << 32)
+            constexpr std::uint64_t mul1 = 0x000f424000000064u;
+            // 1 + (10000 << 32)
+            constexpr std::uint64_t mul2 = 0x0000271000000001u;
+            v -= 0x3030303030303030u;
+            v = (v * 10u) + (v >> 8u);
+            v = (((v & mask) * mul1) + (((v >> 16u) & mask) * mul2)) >> 32u;
+            return static_cast<std::uint32_t>(v);
+        }
+
+        // Bytes of `v` that are >= `n`, as their high bits.
+        // Every byte of `v` must be < 0x80, and `n` <= 0x80.
+        SCN_NODISCARD static std::uint64_t _bytes_at_least(std::uint64_t v,
+                                                           unsigned char n)
+        {
+            return (v + 0x0101010101010101u * (0x80u - n)) &
+                   0x8080808080808080u;
+        }
+        // High bits of the bytes of `v` that are in [lo, hi].
+        // Every byte of `v` must be < 0x80.
+        SCN_NODISCARD static std::uint64_t _bytes_in_range(std::uint64_t v,
+                                                           unsigned char lo,
+                                                           unsigned char hi)
+        {
+            return _bytes_at_least(v, lo) &
+                   ~_bytes_at_least(v, static_cast<unsigned char>(hi + 1));
+        }
+
+        // Value of eight hexadecimal digits in `v`,
+        // the first one in the lowest byte, or -1 if any of them isn't one.
+        SCN_NODISCARD static std::int64_t _parse_eight_hex_digits(
+            std::uint64_t v)
+        {
+            if ((v & 0x8080808080808080u) != 0) {
+                return -1;
+            }
+            // ASCII letters to lowercase, digits are left as they are
+            const auto lower = v | 0x2020202020202020u;
+            const auto letters = _bytes_in_range(lower, 'a', 'f');
+            if ((_bytes_in_range(v, '0', '9') | letters) !=
+                0x8080808080808080u) {
+                return -1;
+            }
+            // '0'-'9' and 'a'-'f' both have their value in the low nibble,
+            // less 9 for letters
+            v = (v & 0x0f0f0f0f0f0f0f0fu) + (letters >> 7u) * 9u;
+            // Combine adjacent nibbles, then bytes, then 16-bit halves
+            v = ((v << 4u) + (v >> 8u)) & 0x00ff00ff00ff00ffu;
+            v = ((v << 8u) + (v >> 16u)) & 0x0000ffff0000ffffu;
+            v = ((v << 16u) + (v >> 32u)) & 0x00000000ffffffffu;
+            return static_cast<std::int64_t>(v);
+        }
+
+        // Value of eight binary digits in `v`,
+        // the first one in the lowest byte, or -1 if any of them isn't one.
+        SCN_NODISCARD static int _parse_eight_binary_digits(std::uint64_t v)
+        {
+            if ((v & 0xfefefefefefefefeu) != 0x3030303030303030u) {
+                return -1;
+            }
+            // Gather the low bit of every byte into the top byte,
+            // the first one as the most significant bit
+            v = ((v & 0x0101010101010101u) * 0x8040201008040201u) >> 56u;
+            return static_cast<int>(v);
+        }
+
+        // Accumulate digits in `base` without checking for overflow,
+        // until the first non-digit or `end`.
+        // `it` is advanced to where the accumulation stopped.
+        template <typename U, typename CharT>
+        static U _accumulate_digits(const CharT*& it,
+                                    const CharT* end,
+                                    U base)
+        {
+            U tmp = 0;
+            for (; it != end; ++it) {
+                const auto digit = _char_to_int(*it);
+                if (digit >= base) {
+                    break;
+                }
+                tmp = static_cast<U>(tmp * base + digit);
+            }
+            return tmp;
+        }
+        template <typename U>
+        static U _accumulate_digits(const char*& it, const char* end, U base)
+        {
+            U tmp = 0;
+            // Eight digits at a time, as far as they go.
+            // Multiplications are done in 64 bits, so that the first group
+            // doesn't overflow U, even if it's just wide enough for it.
+            switch (base) {
+                case 10:
+                    for (; end - it >= 8; it += 8) {
+                        const auto chars = _read_eight_chars(it);
+                        if (!_is_eight_digits(chars)) {
+                            break;
+                        }
+                        tmp = static_cast<U>(
+                            static_cast<std::uint64_t>(tmp) * 100000000u +
+                            _parse_eight_digits(chars));
+                    }
+                    break;
+                case 16:
+                    for (; end - it >= 8; it += 8) {
+                        const auto group =
+                            _parse_eight_hex_digits(_read_eight_chars(it));
+                        if (group < 0) {
+                            break;
+                        }
+                        tmp = static_cast<U>(
+                            (static_cast<std::uint64_t>(tmp) << 32u) |
+                            static_cast<std::uint64_t>(group));
+                    }
+                    break;
+                case 2:
+                    for (; end - it >= 8; it += 8) {
+                        const auto group =
+                            _parse_eight_binary_digits(_read_eight_chars(it));
+                        if (group < 0) {
+                            break;
+                        }
+                        tmp = static_cast<U>(
+                            (static_cast<std::uint64_t>(tmp) << 8u) |
+                            static_cast<std::uint64_t>(group));
+                    }
+                    break;
+                default:
+                    break;
+            }
+            for (; it != end; ++it) {
+                const auto digit = _char_to_int(*it);
+                if (digit >= base) {
+                    break;
+                }
+                tmp = static_cast<U>(tmp * base + digit);
+            }
+            return tmp;
+        }
+
+        // Number of digits in `base` every value of which fits in T,
+        // or 0 if not known for `base`.
+        // A value one digit longer may or may not fit,
+        // and a value longer than that never does.
+        template <typename T>
+        static int _max_safe_digits(unsigned base)
+        {
+            constexpr int bits = std::numeric_limits<T>::digits;
+            switch (base) {
+                case 10:
+                    return std::numeric_limits<T>::digits10;
+                case 2:
+                    return bits;
+                case 8:
+                    return bits / 3;
+                case 16:
+                    return bits / 4;
+                default:
+                    return 0;
+            }
+        }
+
+        // base ** n, for n at most _max_safe_digits<std::uint64_t>(base) - 1
+        static std::uint64_t _pow_u64(unsigned base, std::ptrdiff_t n)
+        {
+            static constexpr std::uint64_t powers_of_ten[] = {
+                1u,
+                10u,
+                100u,
+                1000u,
+                10000u,
+                100000u,
+                1000000u,
+                10000000u,
+                100000000u,
+                1000000000u,
+                10000000000u,
+                100000000000u,
+                1000000000000u,
+                10000000000000u,
+                100000000000000u,
+                1000000000000000u,
+                10000000000000000u,
+                100000000000000000u,
+                1000000000000000000u};
+            const auto un = static_cast<unsigned>(n);
+            switch (base) {
+                case 10:
+                    return powers_of_ten[un];
+                case 2:
+                    return std::uint64_t{1} << un;
+                case 8:
+                    return std::uint64_t{1} << (3u * un);
+                case 16:
+                    return std::uint64_t{1} << (4u * un);
+                default:
+                    SCN_UNREACHABLE;
+            }
+        }
+
+        // Like _accumulate_digits, for types wider than 64 bits:
+        // digits are accumulated in 64-bit chunks as long as they are sure
+        // to fit, and only a finished chunk is folded into the wide value.
+        template <typename U, typename CharT>
+        static U _accumulate_digits(const CharT*& it,
+                                    const CharT* end,
+                                    U base,
+                                    std::true_type)
+        {
+            const auto ubase = static_cast<unsigned>(base);
+            const auto chunk_len = _max_safe_digits<std::uint64_t>(ubase);
+            if (chunk_len == 0) {
+                return _accumulate_digits(it, end, base);
+            }
+
+            const auto base64 = static_cast<std::uint64_t>(base);
+            auto next_chunk_end = [&]() {
+                return end - it > chunk_len ? it + chunk_len : end;
+            };
+
+            // The first chunk is all there is for most values
+            auto chunk_end = next_chunk_end();
+            U tmp = _accumulate_digits(it, chunk_end, base64);
+            while (it == chunk_end && it != end) {
+                const auto chunk_begin = it;
+                chunk_end = next_chunk_end();
+                const auto chunk = _accumulate_digits(it, chunk_end, base64);
+                const auto n = it - chunk_begin;
+                if (n == 0) {
+                    break;
+                }
+                tmp = static_cast<U>(
+                    tmp * (static_cast<U>(_pow_u64(ubase, n - 1)) * base) +
+                    chunk);
+            }
+            return tmp;
+        }
+        template <typename U, typename CharT>
+        static U _accumulate_digits(const CharT*& it,
+                                    const CharT* end,
+                                    U base,
+                                    std::false_type)
+        {
+            return _accumulate_digits(it, end, base);
+        }
+
         template <typename T>
         template <typename CharT>
         expected<typename span<const CharT>::iterator>
@@ -149,9 +429,10 @@ namespace scn {
 
         template <typename T>
         template <typename CharT>
-        expected<std::ptrdiff_t> integer_scanner<T>::_parse_int(
-            T& val,
-            span<const CharT> s)
+        expected<typename span<const CharT>::iterator>
+        integer_scanner<T>::_parse_int_prefix(span<const CharT> s,
+                                              bool& minus_sign,
+                                              bool& only_zero)
         {
             SCN_EXPECT(s.size() > 0);
 
@@ -169,8 +450,6 @@ namespace scn {
 
             SCN_MSVC_POP
 
-            T tmp = 0;
-            bool minus_sign = false;
             auto it = s.begin();
 
             SCN_GCC_PUSH
@@ -205,8 +484,8 @@ namespace scn {
                 }
                 if (b == -1) {
                     // -1 means we read a '0'
-                    val = 0;
-                    return ranges::distance(s.begin(), r.value());
+                    only_zero = true;
+                    return r.value();
                 }
                 if (b != 10 && base != b && base != 0) {
                     return error(error::invalid_scanned_value,
@@ -218,41 +497,242 @@ namespace scn {
                 it = r.value();
             }
 
-            SCN_GCC_PUSH
-            SCN_GCC_IGNORE("-Wconversion")
-            SCN_GCC_IGNORE("-Wsign-conversion")
-            SCN_GCC_IGNORE("-Wsign-compare")
+            return it;
+        }
 
-            SCN_CLANG_PUSH
-            SCN_CLANG_IGNORE("-Wconversion")
-            SCN_CLANG_IGNORE("-Wsign-conversion")
-            SCN_CLANG_IGNORE("-Wsign-compare")
+        template <typename T>
+        template <typename CharT, unsigned Base, unsigned Options>
+        expected<typename span<const CharT>::iterator>
+        integer_scanner<T>::_parse_int_prefix(
+            span<const CharT> s,
+            bool& minus_sign,
+            bool& only_zero,
+            std::integral_constant<unsigned, Base>,
+            std::integral_constant<unsigned, Options>) const
+        {
+            SCN_EXPECT(s.size() > 0);
 
-            SCN_ASSUME(base > 0);
+            SCN_MSVC_PUSH
+            SCN_MSVC_IGNORE(4127)  // conditional expression is constant
 
-            SCN_CLANG_PUSH_IGNORE_UNDEFINED_TEMPLATE
-            auto r = _parse_int_impl(tmp, minus_sign, make_span(it, s.end()));
-            SCN_CLANG_POP_IGNORE_UNDEFINED_TEMPLATE
-            if (!r) {
-                return r.error();
+            auto it = s.begin();
+            if (s[0] == ascii_widen<CharT>('-')) {
+                if (std::is_unsigned<T>::value) {
+                    return error(error::invalid_scanned_value,
+                                 "Unexpected sign '-' when scanning an "
+                                 "unsigned integer");
+                }
+                if ((Options & only_unsigned) != 0) {
+                    return error(error::invalid_scanned_value,
+                                 "Parsed negative value when type was 'u'");
+                }
+                minus_sign = true;
+                ++it;
             }
-            it = r.value();
-            if (s.begin() == it) {
-                return error(error::invalid_scanned_value, "custom::read_int");
+            else if (s[0] == ascii_widen<CharT>('+')) {
+                ++it;
+            }
+            if (SCN_UNLIKELY(it == s.end())) {
+                return error(error::invalid_scanned_value,
+                             "Expected number after sign");
             }
-            val = tmp;
-            return ranges::distance(s.begin(), it);
 
-            SCN_CLANG_POP
-            SCN_GCC_POP
+            if ((Options & allow_base_prefix) != 0) {
+                int b{static_cast<int>(Base)};
+                auto r = parse_base_prefix<CharT>({it, s.end()}, b);
+                if (!r) {
+                    return r.error();
+                }
+                if (b == -1) {
+                    // -1 means we read a '0'
+                    only_zero = true;
+                    return r.value();
+                }
+                // No prefix reads as base 10
+                const bool other_base = b != static_cast<int>(Base);
+                if (b != 10 && other_base) {
+                    return error(error::invalid_scanned_value,
+                                 "Invalid base prefix");
+                }
+                it = r.value();
+            }
+
+            SCN_MSVC_POP
+            return it;
+        }
+
+        // Whether the sizes of digit groups, in the order they were read,
+        // match `grouping`, as returned by std::numpunct::grouping().
+        // The leftmost group may be shorter than its size.
+        static bool _check_grouping(const unsigned char* groups,
+                                    std::size_t n,
+                                    string_view grouping)
+        {
+            SCN_EXPECT(n > 1);
+            for (std::size_t i = 0; i < n; ++i) {
+                const auto size_index =
+                    detail::min(i, grouping.size() - std::size_t{1});
+                const auto size = static_cast<int>(grouping[size_index]);
+                if (size <= 0 || size == CHAR_MAX) {
+                    // No further grouping
+                    return false;
+                }
+                const auto group = static_cast<int>(groups[n - 1 - i]);
+                if (group > size || (i != n - 1 && group != size)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Largest magnitude of a value of type T with the given sign
+        template <typename T>
+        static typename std::make_unsigned<T>::type _magnitude_limit(
+            bool minus_sign)
+        {
+            using utype = typename std::make_unsigned<T>::type;
+            constexpr auto uint_max = static_cast<utype>(-1);
+            constexpr auto int_max = static_cast<utype>(uint_max >> 1);
+            constexpr auto abs_int_min = static_cast<utype>(int_max + 1);
+
+            if (std::is_signed<T>::value) {
+                if (minus_sign) {
+                    return abs_int_min;
+                }
+                return int_max;
+            }
+            return uint_max;
+        }
+
+        // Value of type T with the magnitude `tmp` and the given sign,
+        // `tmp` being at most _magnitude_limit<T>(minus_sign)
+        template <typename T>
+        static T _apply_sign(typename std::make_unsigned<T>::type tmp,
+                             bool minus_sign)
+        {
+            using utype = typename std::make_unsigned<T>::type;
+            if (!minus_sign) {
+                return static_cast<T>(tmp);
+            }
+            // special case: signed int minimum's absolute value can't
+            // be represented with the same type
+            //
+            // For example, short int -- range is [-32768, 32767], 32768
+            // can't be represented
+            //
+            // In that case, -static_cast<T>(tmp) would trigger UB
+            if (std::is_signed<T>::value &&
+                SCN_UNLIKELY(tmp == _magnitude_limit<T>(true))) {
+                return std::numeric_limits<T>::min();
+            }
+            return static_cast<T>(static_cast<utype>(0u - tmp));
         }
 
         template <typename T>
         template <typename CharT>
-        expected<typename span<const CharT>::iterator>
-        integer_scanner<T>::_parse_int_impl(T& val,
-                                            bool minus_sign,
-                                            span<const CharT> buf) const
+        expected<std::ptrdiff_t> integer_scanner<T>::_parse_int_grouped(
+            T& val,
+            span<const CharT> s,
+            CharT thsep,
+            string_view grouping)
+        {
+            bool minus_sign = false;
+            bool only_zero = false;
+            auto prefix = _parse_int_prefix(s, minus_sign, only_zero);
+            if (!prefix) {
+                return prefix.error();
+            }
+            if (only_zero) {
+                val = 0;
+                return ranges::distance(s.begin(), prefix.value());
+            }
+
+            // Find the end of the digits and separators,
+            // and check the sizes of the groups of digits between them
+            // against `grouping`
+            unsigned char groups[max_literal_length];
+            std::size_t digit_count = 0;
+            std::size_t group_count = 0;
+            unsigned char group = 0;
+
+            const auto ubase = static_cast<unsigned>(base);
+            const auto digits_begin = prefix.value();
+            auto digits_end = digits_begin;
+            for (auto it = digits_begin; it != s.end(); ++it) {
+                if (_char_to_int(*it) < ubase) {
+                    if (SCN_UNLIKELY(digit_count == max_literal_length)) {
+                        return error(error::value_out_of_range,
+                                     "Integer literal too long");
+                    }
+                    ++digit_count;
+                    // Saturate: any group this long is already invalid,
+                    // but it mustn't wrap around to a valid size
+                    if (group != UCHAR_MAX) {
+                        ++group;
+                    }
+                    digits_end = it + 1;
+                    continue;
+                }
+                if (*it == thsep && !grouping.empty() && group != 0) {
+                    groups[group_count++] = group;
+                    group = 0;
+                    continue;
+                }
+                break;
+            }
+            if (group == 0 && group_count != 0) {
+                // Separator not followed by a digit: not a part of the number
+                group = groups[--group_count];
+            }
+            if (group_count != 0) {
+                groups[group_count++] = group;
+                if (!_check_grouping(groups, group_count, grouping)) {
+                    return error(error::invalid_scanned_value,
+                                 "Invalid digit grouping");
+                }
+            }
+
+            if (SCN_UNLIKELY(digit_count == 0)) {
+                return error(error::invalid_scanned_value,
+                             "Expected digits");
+            }
+
+            // Accumulate the digits straight from `s`, skipping the
+            // separators
+            using utype = typename std::make_unsigned<T>::type;
+            const auto cut =
+                div(_magnitude_limit<T>(minus_sign), static_cast<utype>(ubase));
+            utype tmp = 0;
+            for (auto it = digits_begin; it != digits_end; ++it) {
+                if (*it == thsep) {
+                    continue;
+                }
+                const auto digit = _char_to_int(*it);
+                if (SCN_UNLIKELY(tmp > cut.first ||
+                                 (tmp == cut.first && digit > cut.second))) {
+                    if (!minus_sign) {
+                        return error(error::value_out_of_range,
+                                     "Out of range: integer overflow");
+                    }
+                    return error(error::value_out_of_range,
+                                 "Out of range: integer underflow");
+                }
+                tmp = static_cast<utype>(tmp * ubase + digit);
+            }
+            val = _apply_sign<T>(tmp, minus_sign);
+            return ranges::distance(s.begin(), digits_end);
+        }
+
+        // Digits of a value of type T in `base`, from `it` until the first
+        // non-digit or `end`, checked for overflow.
+        // `base` is either an unsigned or a std::integral_constant;
+        // with the latter, the branches on it are resolved at compile time.
+        template <typename T, typename Base, typename CharT>
+        static expected<const CharT*> _parse_magnitude(T& val,
+                                                       bool minus_sign,
+                                                       const CharT* it,
+                                                       const CharT* end,
+                                                       Base base)
         {
             SCN_GCC_PUSH
             SCN_GCC_IGNORE("-Wconversion")
@@ -271,64 +751,71 @@ namespace scn {
 
             using utype = typename std::make_unsigned<T>::type;
 
-            const auto ubase = static_cast<utype>(base);
+            const auto ubase =
+                static_cast<utype>(static_cast<unsigned>(base));
             SCN_ASSUME(ubase > 0);
 
-            constexpr auto uint_max = static_cast<utype>(-1);
-            constexpr auto int_max = static_cast<utype>(uint_max >> 1);
-            constexpr auto abs_int_min = static_cast<utype>(int_max + 1);
-
-            const auto cut = div(
-                [&]() -> utype {
-                    if (std::is_signed<T>::value) {
-                        if (minus_sign) {
-                            return abs_int_min;
-                        }
-                        return int_max;
-                    }
-                    return uint_max;
-                }(),
-                ubase);
+            const auto cut = div(_magnitude_limit<T>(minus_sign), ubase);
             const auto cutoff = cut.first;
             const auto cutlim = cut.second;
 
-            auto it = buf.begin();
-            const auto end = buf.end();
-            utype tmp = 0;
-            for (; it != end; ++it) {
-                const auto digit = _char_to_int(*it);
-                if (digit >= ubase) {
-                    break;
-                }
-                if (SCN_UNLIKELY(tmp > cutoff ||
-                                 (tmp == cutoff && digit > cutlim))) {
-                    if (!minus_sign) {
-                        return error(error::value_out_of_range,
-                                     "Out of range: integer overflow");
-                    }
+            const auto overflow_error = [&]() {
+                if (!minus_sign) {
                     return error(error::value_out_of_range,
-                                 "Out of range: integer underflow");
+                                 "Out of range: integer overflow");
                 }
-                tmp = tmp * ubase + digit;
-            }
-            if (minus_sign) {
-                // special case: signed int minimum's absolute value can't
-                // be represented with the same type
-                //
-                // For example, short int -- range is [-32768, 32767], 32768
-                // can't be represented
-                //
-                // In that case, -static_cast<T>(tmp) would trigger UB
-                if (SCN_UNLIKELY(tmp == abs_int_min)) {
-                    val = std::numeric_limits<T>::min();
+                return error(error::value_out_of_range,
+                             "Out of range: integer underflow");
+            };
+
+            utype tmp = 0;
+
+            const auto safe_digits = _max_safe_digits<T>(base);
+            if (SCN_LIKELY(safe_digits != 0)) {
+                // Leading zeroes don't count towards the length
+                while (it != end && _char_to_int(*it) == 0) {
+                    ++it;
                 }
-                else {
-                    val = -static_cast<T>(tmp);
+
+                // Values shorter than the maximum length can't overflow.
+                // Only the last digit of a maximum-length one needs checking,
+                // and a value longer than that always overflows.
+                const auto safe_end =
+                    end - it > safe_digits ? it + safe_digits : end;
+                tmp = _accumulate_digits(
+                    it, safe_end, ubase,
+                    std::integral_constant<bool, (sizeof(utype) >
+                                                  sizeof(std::uint64_t))>{});
+                if (it == safe_end && it != end) {
+                    const auto digit = _char_to_int(*it);
+                    if (digit < ubase) {
+                        if (SCN_UNLIKELY(tmp > cutoff ||
+                                         (tmp == cutoff && digit > cutlim))) {
+                            return overflow_error();
+                        }
+                        tmp = tmp * ubase + digit;
+                        ++it;
+                        if (SCN_UNLIKELY(it != end &&
+                                         _char_to_int(*it) < ubase)) {
+                            return overflow_error();
+                        }
+                    }
                 }
             }
             else {
-                val = static_cast<T>(tmp);
+                for (; it != end; ++it) {
+                    const auto digit = _char_to_int(*it);
+                    if (digit >= ubase) {
+                        break;
+                    }
+                    if (SCN_UNLIKELY(tmp > cutoff ||
+                                     (tmp == cutoff && digit > cutlim))) {
+                        return overflow_error();
+                    }
+                    tmp = tmp * ubase + digit;
+                }
             }
+            val = _apply_sign<T>(tmp, minus_sign);
             return it;
 
             SCN_MSVC_POP
@@ -336,16 +823,124 @@ namespace scn {
             SCN_GCC_POP
         }
 
+
+        // The rest of _parse_int, after the sign and the base prefix
+        template <typename T, typename Base, typename CharT>
+        static expected<std::ptrdiff_t> _parse_int_digits(T& val,
+                                                          span<const CharT> s,
+                                                          const CharT* it,
+                                                          bool minus_sign,
+                                                          Base base)
+        {
+            T tmp = 0;
+            auto r = _parse_magnitude(tmp, minus_sign, it, s.end(), base);
+            if (!r) {
+                return r.error();
+            }
+            it = r.value();
+            if (s.begin() == it) {
+                return error(error::invalid_scanned_value, "custom::read_int");
+            }
+            val = tmp;
+            return ranges::distance(s.begin(), it);
+        }
+
+        template <typename T>
+        template <typename CharT>
+        expected<std::ptrdiff_t> integer_scanner<T>::_parse_int(
+            T& val,
+            span<const CharT> s)
+        {
+            bool minus_sign = false;
+            bool only_zero = false;
+            auto prefix = _parse_int_prefix(s, minus_sign, only_zero);
+            if (!prefix) {
+                return prefix.error();
+            }
+            if (only_zero) {
+                val = 0;
+                return ranges::distance(s.begin(), prefix.value());
+            }
+
+            // `base` may have been set from the prefix
+            SCN_ASSUME(base > 0);
+            return _parse_int_digits(val, s, prefix.value(), minus_sign,
+                                     static_cast<unsigned>(base));
+        }
+
+        template <typename T>
+        template <typename CharT>
+        expected<typename span<const CharT>::iterator>
+        integer_scanner<T>::_parse_int_impl(T& val,
+                                            bool minus_sign,
+                                            span<const CharT> buf) const
+        {
+            SCN_ASSUME(base > 0);
+            return _parse_magnitude(val, minus_sign, buf.begin(), buf.end(),
+                                    static_cast<unsigned>(base));
+        }
+
+        template <typename T>
+        template <unsigned Base, unsigned Options, typename CharT>
+        expected<std::ptrdiff_t> integer_scanner<T>::_parse_int_fixed_base(
+            T& val,
+            span<const CharT> s)
+        {
+            SCN_EXPECT(base == Base);
+            SCN_EXPECT(format_options == Options);
+
+            bool minus_sign = false;
+            bool only_zero = false;
+            auto prefix = _parse_int_prefix(
+                s, minus_sign, only_zero,
+                std::integral_constant<unsigned, Base>{},
+                std::integral_constant<unsigned, Options>{});
+            if (!prefix) {
+                return prefix.error();
+            }
+            if (only_zero) {
+                val = 0;
+                return ranges::distance(s.begin(), prefix.value());
+            }
+            return _parse_int_digits(val, s, prefix.value(), minus_sign,
+                                     std::integral_constant<unsigned, Base>{});
+        }
+
 #if SCN_INCLUDE_SOURCE_DEFINITIONS
 
 #define SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(CharT, T)             \
     template expected<std::ptrdiff_t> integer_scanner<T>::_parse_int( \
         T& val, span<const CharT> s);                                 \
     template expected<typename span<const CharT>::iterator>           \
+    integer_scanner<T>::_parse_int_prefix(span<const CharT> s,        \
+                                          bool& minus_sign,           \
+                                          bool& only_zero);           \
+    template expected<std::ptrdiff_t>                                 \
+    integer_scanner<T>::_parse_int_grouped(                           \
+        T& val, span<const CharT> s, CharT thsep,                     \
+        string_view grouping);                                        \
+    template expected<typename span<const CharT>::iterator>           \
     integer_scanner<T>::_parse_int_impl(T& val, bool minus_sign,      \
                                         span<const CharT> buf) const; \
     template expected<typename span<const CharT>::iterator>           \
-    integer_scanner<T>::parse_base_prefix(span<const CharT>, int&) const;
+    integer_scanner<T>::parse_base_prefix(span<const CharT>, int&) const; \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE(CharT, T, 2)                \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE(CharT, T, 8)                \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE(CharT, T, 10)               \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE(CharT, T, 16)
+
+#define SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE(CharT, T, Base)   \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE_IMPL(CharT, T, Base, 0) \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE_IMPL(CharT, T, Base, 4) \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE_IMPL(CharT, T, Base, 8) \
+    SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE_IMPL(CharT, T, Base, 12)
+
+// Options: any combination of integer_format_unsigned (4)
+// and integer_format_prefix (8)
+#define SCN_DEFINE_INTEGER_SCANNER_FIXED_BASE_IMPL(CharT, T, Base, Options) \
+    template expected<std::ptrdiff_t>                                      \
+    integer_scanner<T>::_parse_int_fixed_base<Base, Options>(              \
+        T & val, span<const CharT> s);
 
 #define SCN_DEFINE_INTEGER_SCANNER_MEMBERS(Char)                      \
     SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, signed char)        \
@@ -359,7 +954,16 @@ namespace scn {
     SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, unsigned long)      \
     SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, unsigned long long) \
     SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, char)               \
-    SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, wchar_t)
+    SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, wchar_t)            \
+    SCN_DEFINE_INTEGER_SCANNER_MEMBERS_INT128(Char)
+
+#if SCN_HAS_INT128
+#define SCN_DEFINE_INTEGER_SCANNER_MEMBERS_INT128(Char)  \
+    SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, int128) \
+    SCN_DEFINE_INTEGER_SCANNER_MEMBERS_IMPL(Char, uint128)
+#else
+#define SCN_DEFINE_INTEGER_SCANNER_MEMBERS_INT128(Char)
+#endif
 
         SCN_DEFINE_INTEGER_SCANNER_MEMBERS(char)
         SCN_DEFINE_INTEGER_SCANNER_MEMBERS(wchar_t)
@@ -73,6 +73,8 @@ namespace scn {
     SCN_VSCAN_DEFINE(std::wstring, wstring_wrapped, wstring_char)
     SCN_VSCAN_DEFINE(file&, file_ref_wrapped, file_ref_char)
     SCN_VSCAN_DEFINE(wfile&, wfile_ref_wrapped, wfile_ref_char)
+    SCN_VSCAN_DEFINE(fd_file&, fd_file_ref_wrapped, fd_file_ref_char)
+    SCN_VSCAN_DEFINE(wfd_file&, wfd_file_ref_wrapped, wfd_file_ref_char)
 
 #endif
 
@@ -20,6 +20,10 @@
 #include <istream>
 #include "../test.h"
 
+#if SCN_POSIX
+#include <unistd.h>
+#endif
+
 static bool do_fgets(char* str, size_t count, std::FILE* f)
 {
     return std::fgets(str, static_cast<int>(count), f) != nullptr;
@@ -81,7 +85,8 @@ TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
         CHECK(word == widen<CharT>("word"));
         file.sync();
 
-        word = widen<CharT>("another");
+        // whitespace following a scanned value is not consumed
+        word = widen<CharT>(" another");
 
         std::vector<CharT> buf(word.size() + 1, 0);
         bool fgets_ret = do_fgets(buf.data(), buf.size(), file.handle());
@@ -104,14 +109,15 @@ TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
         CHECK(result);
         CHECK(word == widen<CharT>("123"));
 
-        // syncing required to use the file handle
-        word = widen<CharT>("word");
-        std::vector<CharT> buf(word.size() + 1, 0);
-        bool fgets_ret = do_fgets(buf.data(), buf.size(), file.handle());
-        CHECK(fgets_ret);
-        CHECK(word == string_type{buf.data()});
+        // the result range can still be used
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == widen<CharT>("word"));
+
+        // syncing required to use the file handle:
+        // it's been read past the scanned values
+        CHECK(std::ftell(file.handle()) > 8);
         CHECK(std::ferror(file.handle()) == 0);
-        CHECK(std::feof(file.handle()) == 0);
     }
 
     SUBCASE("error")
@@ -151,6 +157,279 @@ TEST_CASE_TEMPLATE("file", CharT, char, wchar_t)
     }
 }
 
+TEST_CASE("wfile utf8")
+{
+    // Multi-byte sequences of every length end up cut off by block
+    // boundaries
+    const auto word = std::wstring{L"a\u00e4\u20ac\U0001F600"};
+    const char* word_utf8 = "a\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80";
+    constexpr int word_count = 4096;
+
+    scn::owning_wfile file{std::tmpfile()};
+    REQUIRE(file.is_open());
+    file.set_utf8();
+    for (int i = 0; i < word_count; ++i) {
+        std::fprintf(file.handle(), "%s%d ", word_utf8, i);
+    }
+    std::fputs("tail", file.handle());
+    std::rewind(file.handle());
+
+    SUBCASE("entire file")
+    {
+        auto result = scn::make_result(file);
+        int count = 0;
+        for (; count < word_count; ++count) {
+            std::wstring w;
+            result = scn::scan_default(result.range(), w);
+            if (!result) {
+                break;
+            }
+            if (w != word + std::to_wstring(count)) {
+                break;
+            }
+        }
+        CHECK(count == word_count);
+    }
+    SUBCASE("syncing")
+    {
+        std::wstring w;
+        auto result = scn::scan_default(file, w);
+        CHECK(result);
+        CHECK(w == word + L"0");
+        CHECK(file.sync());
+
+        // Only the bytes of the scanned word are consumed
+        std::vector<char> buf(64, 0);
+        CHECK(std::fgets(buf.data(), 13, file.handle()));
+        CHECK(std::string{buf.data()} == std::string{" "} + word_utf8 + "1");
+    }
+    SUBCASE("open")
+    {
+        const char* filename = "./wfile_utf8_test.txt";
+        {
+            auto f = std::fopen(filename, "w");
+            REQUIRE(f);
+            std::fprintf(f, "%s0 %s1", word_utf8, word_utf8);
+            std::fclose(f);
+        }
+
+        // Not set to wide orientation by open()
+        scn::owning_wfile named{};
+        named.set_utf8();
+        REQUIRE(named.open(filename, "r"));
+        CHECK(std::fwide(named.handle(), 0) == 0);
+
+        std::wstring w;
+        auto result = scn::scan_default(named, w);
+        CHECK(result);
+        CHECK(w == word + L"0");
+        CHECK(named.sync());
+
+        std::vector<char> buf(64, 0);
+        CHECK(std::fgets(buf.data(), 13, named.handle()));
+        CHECK(std::string{buf.data()} == std::string{" "} + word_utf8 + "1");
+
+        named.close();
+        std::remove(filename);
+    }
+}
+
+TEST_CASE("wfile wide-oriented")
+{
+    scn::owning_wfile file{"./test/file/testfile.txt", "r"};
+    REQUIRE(file.is_open());
+    file.set_utf8();
+    // Read with fgetwc, as the stream is already wide-oriented
+    REQUIRE(std::fwide(file.handle(), 1) > 0);
+
+    int i;
+    auto result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+    file.sync();
+
+    std::vector<wchar_t> buf(8, 0);
+    CHECK(std::fgetws(buf.data(), 2, file.handle()));
+    CHECK(std::wstring{buf.data()} == L"\n");
+}
+
+TEST_CASE("wfile invalid utf8")
+{
+    scn::owning_wfile file{std::tmpfile()};
+    REQUIRE(file.is_open());
+    file.set_utf8();
+    std::fputs("abc\xff ", file.handle());
+    std::rewind(file.handle());
+
+    // Characters before the invalid sequence are still read,
+    // after that the file can't be read further
+    std::wstring w;
+    auto result = scn::scan_default(file, w);
+    CHECK(result);
+    CHECK(w == L"abc");
+
+    result = scn::scan_default(result.range(), w);
+    CHECK(!result);
+}
+
+TEST_CASE("windowed file")
+{
+    // Large enough to be many times the size of a single block read
+    constexpr int value_count = 1 << 20;
+    constexpr std::size_t capacity_limit = 16 * scn::detail::file_block_size;
+
+    scn::owning_file file{std::tmpfile()};
+    REQUIRE(file.is_open());
+    long long expected_sum = 0;
+    for (int i = 0; i < value_count; ++i) {
+        std::fprintf(file.handle(), "%d\n", i);
+        expected_sum += i;
+    }
+    std::rewind(file.handle());
+
+    file.set_windowed();
+    CHECK(file.windowed());
+
+    long long sum = 0;
+    int count = 0;
+    std::size_t max_capacity = 0;
+    auto result = scn::make_result(file);
+    while (true) {
+        int i{};
+        result = scn::scan_default(result.range(), i);
+        if (!result) {
+            break;
+        }
+        sum += i;
+        ++count;
+        max_capacity = (std::max)(max_capacity, file.buffer_capacity());
+    }
+    CHECK(result.error().code() == scn::error::end_of_range);
+    CHECK(count == value_count);
+    CHECK(sum == expected_sum);
+    CHECK(max_capacity <= capacity_limit);
+}
+
+TEST_CASE("file sync with fscanf")
+{
+    // Every scnlib read pulls in a whole block,
+    // which needs to be given back to the FILE* on sync
+    constexpr int value_count = 4096;
+
+    scn::owning_file file{std::tmpfile()};
+    REQUIRE(file.is_open());
+    for (int i = 0; i < value_count; ++i) {
+        std::fprintf(file.handle(), "%d ", i);
+    }
+    std::rewind(file.handle());
+
+    for (int i = 0; i < value_count; i += 2) {
+        int a{}, b{};
+        auto result = scn::scan_default(file, a);
+        CHECK(result);
+        CHECK(a == i);
+        CHECK(file.sync());
+
+        CHECK(std::fscanf(file.handle(), "%d", &b) == 1);
+        CHECK(b == i + 1);
+    }
+    CHECK(std::ferror(file.handle()) == 0);
+}
+
+TEST_CASE("fd file")
+{
+    scn::owning_fd_file file{"./test/file/testfile.txt"};
+    REQUIRE(file.is_open());
+
+    SUBCASE("entire file")
+    {
+        auto result = scn::make_result(file);
+
+        int i;
+        result = scn::scan_default(result.range(), i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        std::string word;
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == "word");
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == "another");
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+    SUBCASE("error")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        result = scn::scan_default(result.range(), i);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::invalid_scanned_value);
+
+        std::string word;
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == "word");
+    }
+    SUBCASE("getline")
+    {
+        std::string line;
+        auto result = scn::getline(file, line);
+        CHECK(result);
+        CHECK(line == "123");
+
+        result = scn::getline(result.range(), line);
+        CHECK(result);
+        CHECK(line == "word another");
+    }
+#if SCN_POSIX
+    SUBCASE("syncing")
+    {
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+        file.sync();
+
+        char buf[6] = {0};
+        CHECK(::read(file.handle(), buf, 5) == 5);
+        CHECK(std::string{buf} == "\nword");
+    }
+#endif
+}
+
+#if SCN_POSIX
+TEST_CASE("fd file pipe")
+{
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    const char input[] = "123 456\n789";
+    REQUIRE(::write(fds[1], input, sizeof(input) - 1) ==
+            static_cast<ssize_t>(sizeof(input) - 1));
+    ::close(fds[1]);
+
+    scn::owning_fd_file file{fds[0]};
+    int a{}, b{}, c{};
+    auto result = scn::scan_default(file, a, b, c);
+    CHECK(result);
+    CHECK(a == 123);
+    CHECK(b == 456);
+    CHECK(c == 789);
+
+    result = scn::scan_default(result.range(), a);
+    CHECK(!result);
+    CHECK(result.error().code() == scn::error::end_of_range);
+}
+#endif
+
 TEST_CASE("mapped file")
 {
     scn::mapped_file file{"./test/file/testfile.txt"};
@@ -188,6 +467,351 @@ TEST_CASE("mapped file")
     }
 }
 
+TEST_CASE("mapped file options")
+{
+    scn::mapped_file_options opt{};
+    opt.sequential = true;
+    opt.will_need = true;
+    opt.huge_pages = true;
+    opt.populate = true;
+    opt.drop_consumed = true;
+    scn::mapped_file file{"./test/file/testfile.txt", opt};
+    REQUIRE(file.valid());
+
+    int i;
+    auto result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+    file.discard_until(result.range().data());
+
+    // discarded pages are read back in
+    result = scn::scan_default(file, i);
+    CHECK(result);
+    CHECK(i == 123);
+}
+
+TEST_CASE("windowed mapped file")
+{
+    // Values of varying lengths, so that they cross window boundaries at
+    // every possible offset
+    constexpr int value_count = 1 << 16;
+    const char* filename = "./windowed_mapped_file_test.txt";
+    long long expected_sum = 0;
+    {
+        auto f = std::fopen(filename, "w");
+        REQUIRE(f);
+        for (int i = 0; i < value_count; ++i) {
+            std::fprintf(f, "%d word%d\n", i * 7919, i);
+            expected_sum += i * 7919;
+        }
+        std::fclose(f);
+    }
+
+    {
+        // Smallest possible window: a single page
+        scn::windowed_mapped_file file{filename, 1};
+        REQUIRE(file.valid());
+        CHECK(file.window_size() < file.size());
+
+        long long sum = 0;
+        int count = 0;
+        std::string word;
+        auto result = scn::make_result(file);
+        while (true) {
+            int i{};
+            result = scn::scan_default(result.range(), i);
+            if (!result) {
+                break;
+            }
+            sum += i;
+
+            // Failure rolls back to the beginning of the word,
+            // even if the window had to slide
+            result = scn::scan_default(result.range(), i);
+            CHECK(!result);
+            CHECK(result.error().code() == scn::error::invalid_scanned_value);
+
+            result = scn::scan_default(result.range(), word);
+            CHECK(result);
+            CHECK(word == "word" + std::to_string(count));
+            ++count;
+        }
+        CHECK(result.error().code() == scn::error::end_of_range);
+        CHECK(count == value_count);
+        CHECK(sum == expected_sum);
+    }
+
+    std::remove(filename);
+}
+
+TEST_CASE("transcoding mapped wfile")
+{
+    SUBCASE("small")
+    {
+        scn::transcoding_mapped_wfile file{"./test/file/testfile.txt"};
+        REQUIRE(file.valid());
+
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        std::wstring word;
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == L"word");
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == L"another");
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+    SUBCASE("many chunks")
+    {
+        // Multi-byte sequences end up cut off by chunk boundaries
+        const auto word = std::wstring{L"a\u00e4\u20ac\U0001F600"};
+        const char* word_utf8 = "a\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80";
+        constexpr int word_count = 1 << 15;
+        const char* filename = "./transcoding_mapped_test.txt";
+        {
+            auto f = std::fopen(filename, "w");
+            REQUIRE(f);
+            for (int i = 0; i < word_count; ++i) {
+                std::fprintf(f, "%s%d\n", word_utf8, i);
+            }
+            std::fclose(f);
+        }
+
+        {
+            scn::mapped_file_options opt{};
+            opt.drop_consumed = true;
+            scn::transcoding_mapped_wfile file{filename, opt};
+            REQUIRE(file.valid());
+
+            auto result = scn::make_result(file);
+            int count = 0;
+            for (; count < word_count; ++count) {
+                std::wstring w;
+                result = scn::scan_default(result.range(), w);
+                if (!result || w != word + std::to_wstring(count)) {
+                    break;
+                }
+            }
+            CHECK(count == word_count);
+
+            std::wstring w;
+            result = scn::scan_default(result.range(), w);
+            CHECK(result.error().code() == scn::error::end_of_range);
+        }
+
+        std::remove(filename);
+    }
+}
+
+#if SCN_HAS_READAHEAD_FILE
+TEST_CASE("readahead file")
+{
+    SUBCASE("small")
+    {
+        scn::readahead_file file{"./test/file/testfile.txt"};
+        REQUIRE(file.valid());
+
+        int i;
+        auto result = scn::scan_default(file, i);
+        CHECK(result);
+        CHECK(i == 123);
+
+        result = scn::scan_default(result.range(), i);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::invalid_scanned_value);
+
+        std::string word;
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == "word");
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(result);
+        CHECK(word == "another");
+
+        result = scn::scan_default(result.range(), word);
+        CHECK(!result);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+    SUBCASE("many blocks")
+    {
+        constexpr int value_count = 1 << 18;
+        const char* filename = "./readahead_file_test.txt";
+        long long expected_sum = 0;
+        {
+            auto f = std::fopen(filename, "w");
+            REQUIRE(f);
+            for (int i = 0; i < value_count; ++i) {
+                std::fprintf(f, "%d\n", i);
+                expected_sum += i;
+            }
+            std::fclose(f);
+        }
+
+        {
+            scn::readahead_file file{filename};
+            REQUIRE(file.valid());
+
+            long long sum = 0;
+            int count = 0;
+            auto result = scn::make_result(file);
+            while (true) {
+                int i{};
+                result = scn::scan_default(result.range(), i);
+                if (!result) {
+                    break;
+                }
+                sum += i;
+                ++count;
+            }
+            CHECK(result.error().code() == scn::error::end_of_range);
+            CHECK(count == value_count);
+            CHECK(sum == expected_sum);
+        }
+
+        std::remove(filename);
+    }
+    SUBCASE("not read to the end")
+    {
+        // The reading thread is stopped on destruction
+        scn::readahead_file file{"./test/file/testfile.txt"};
+        REQUIRE(file.valid());
+    }
+#if SCN_POSIX
+    SUBCASE("pipe")
+    {
+        // Not read: joining the thread could block forever
+        int fds[2];
+        REQUIRE(::pipe(fds) == 0);
+        {
+            scn::readahead_file file{fds[0]};
+            CHECK(!file.valid());
+        }
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+#endif
+}
+#endif
+
+TEST_CASE("uring file")
+{
+    constexpr int value_count = 1 << 16;
+    const char* filename = "./uring_file_test.txt";
+    long long expected_sum = 0;
+    {
+        auto f = std::fopen(filename, "w");
+        REQUIRE(f);
+        for (int i = 0; i < value_count; ++i) {
+            std::fprintf(f, "%d\n", i);
+            expected_sum += i;
+        }
+        std::fclose(f);
+    }
+
+    scn::uring_file_options opt{};
+    SUBCASE("default") {}
+    SUBCASE("small blocks")
+    {
+        // Block boundaries fall inside numbers
+        opt.queue_depth = 3;
+        opt.block_size = 61;
+    }
+    SUBCASE("fallback")
+    {
+        opt.disable_io_uring = true;
+        opt.block_size = 4096;
+    }
+
+    {
+        scn::uring_file file{filename, opt};
+        REQUIRE(file.valid());
+        if (opt.disable_io_uring) {
+            CHECK(!file.uses_io_uring());
+        }
+
+        long long sum = 0;
+        int count = 0;
+        auto result = scn::make_result(file);
+        while (true) {
+            int i{};
+            result = scn::scan_default(result.range(), i);
+            if (!result) {
+                break;
+            }
+            sum += i;
+            ++count;
+        }
+        CHECK(result.error().code() == scn::error::end_of_range);
+        CHECK(count == value_count);
+        CHECK(sum == expected_sum);
+
+        // EOF is sticky
+        result = scn::scan_default(result.range(), count);
+        CHECK(result.error().code() == scn::error::end_of_range);
+    }
+
+    std::remove(filename);
+}
+
+TEST_CASE("uring wfile")
+{
+    constexpr int value_count = 1 << 12;
+    const char* filename = "./uring_wfile_test.txt";
+    long long expected_sum = 0;
+    {
+        auto f = std::fopen(filename, "wb");
+        REQUIRE(f);
+        for (int i = 0; i < value_count; ++i) {
+            const auto str = std::to_wstring(i) + L' ';
+            std::fwrite(str.data(), sizeof(wchar_t), str.size(), f);
+            expected_sum += i;
+        }
+        std::fclose(f);
+    }
+
+    scn::uring_file_options opt{};
+    SUBCASE("default") {}
+    SUBCASE("split characters")
+    {
+        // Block boundaries fall inside wide characters,
+        // so the rest of the block is misaligned
+        opt.queue_depth = 2;
+        opt.block_size = 61;
+    }
+
+    {
+        scn::uring_wfile file{filename, opt};
+        REQUIRE(file.valid());
+
+        long long sum = 0;
+        int count = 0;
+        auto result = scn::make_result(file);
+        while (true) {
+            int i{};
+            result = scn::scan_default(result.range(), i);
+            if (!result) {
+                break;
+            }
+            sum += i;
+            ++count;
+        }
+        CHECK(result.error().code() == scn::error::end_of_range);
+        CHECK(count == value_count);
+        CHECK(sum == expected_sum);
+    }
+
+    std::remove(filename);
+}
+
 struct int_and_string {
     int i;
     std::string s;
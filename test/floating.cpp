@@ -16,7 +16,13 @@
 //     https://github.com/eliaskosunen/scnlib
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
 
 #include "test.h"
 
@@ -282,6 +288,413 @@ TEST_CASE("parse_float")
     CHECK(d == doctest::Approx(3.14));
 }
 
+TEST_CASE("parse_float in place")
+{
+    SUBCASE("bounded by the view")
+    {
+        // The parsers must stop at the end of the view,
+        // even when the underlying buffer continues
+        scn::string_view full = "1.25e3";
+        scn::string_view source{full.data(), 4};
+        double d{};
+        auto ret = scn::parse_float(source, d);
+        CHECK(ret);
+        CHECK(ret.value() == full.begin() + 4);
+        CHECK(d == doctest::Approx(1.25));
+
+        long double ld{};
+        auto ret_ld = scn::parse_float(source, ld);
+        CHECK(ret_ld);
+        CHECK(ret_ld.value() == full.begin() + 4);
+        CHECK(ld == doctest::Approx(1.25));
+    }
+    SUBCASE("hexfloat")
+    {
+        scn::string_view full = "0x1.8p1 x";
+        scn::string_view source{full.data(), 7};
+        double d{};
+        auto ret = scn::parse_float(source, d);
+        CHECK(ret);
+        CHECK(ret.value() == full.begin() + 7);
+        CHECK(d == doctest::Approx(3.0));
+    }
+    SUBCASE("long token")
+    {
+        // Longer than the stack buffer used for the strtod fallback
+        std::string str = "1." + std::string(100, '0') + "1";
+        double d{};
+        auto ret = scn::scan(str, "{}", d);
+        CHECK(ret);
+        CHECK(ret.empty());
+        CHECK(d == doctest::Approx(1.0));
+
+        long double ld{};
+        auto ret_ld = scn::scan(str, "{}", ld);
+        CHECK(ret_ld);
+        CHECK(ret_ld.empty());
+        CHECK(ld == doctest::Approx(1.0));
+
+        std::wstring wstr = L"2." + std::wstring(100, L'0') + L"1";
+        auto ret_w = scn::scan(wstr, L"{}", d);
+        CHECK(ret_w);
+        CHECK(ret_w.empty());
+        CHECK(d == doctest::Approx(2.0));
+    }
+}
+
+// Parses str with both scn::parse_float and strtod-like `ref`,
+// and checks that the results are bit-identical
+template <typename T, typename CharT, typename F>
+static bool matches_reference(const std::basic_string<CharT>& str, F ref)
+{
+    CharT* ref_end{};
+    errno = 0;
+    const T expected = ref(str.c_str(), &ref_end);
+    const bool ref_range_error =
+        errno == ERANGE && (std::fpclassify(expected) == FP_ZERO ||
+                            std::isinf(expected));
+    errno = 0;
+
+    T val{};
+    auto ret = scn::parse_float(
+        scn::basic_string_view<CharT>{str.data(), str.size()}, val);
+    if (ref_range_error) {
+        return !ret && ret.error() == scn::error::value_out_of_range;
+    }
+    // Not memcmp: long double may have padding bytes
+    return ret && ret.value() == ref_end && !(val < expected) &&
+           !(val > expected) && std::signbit(val) == std::signbit(expected);
+}
+
+static std::string random_hexfloat(std::mt19937_64& rng, int max_exp)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::uniform_int_distribution<int> ndigits(1, 24);
+    std::uniform_int_distribution<int> digit(0, 15);
+    std::uniform_int_distribution<int> exp(-max_exp, max_exp);
+
+    std::string str = rng() % 2 ? "-0x" : "0x";
+    const int n = ndigits(rng);
+    const int point = static_cast<int>(rng() % static_cast<unsigned>(n + 1));
+    for (int i = 0; i < n; ++i) {
+        if (i == point) {
+            str += '.';
+        }
+        str += digits[digit(rng)];
+    }
+    str += 'p';
+    str += std::to_string(exp(rng));
+    return str;
+}
+
+TEST_CASE("hexfloat")
+{
+    std::mt19937_64 rng{42};
+    const int iterations = 1 << 14;
+
+    SUBCASE("double bit patterns")
+    {
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto bits = rng();
+            double d{};
+            std::memcpy(&d, &bits, sizeof(d));
+            if (std::isnan(d) || std::isinf(d)) {
+                continue;
+            }
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "%a", d);
+            if (!matches_reference<double>(std::string{buf}, std::strtod)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("float bit patterns")
+    {
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto bits = static_cast<uint32_t>(rng());
+            float f{};
+            std::memcpy(&f, &bits, sizeof(f));
+            if (std::isnan(f) || std::isinf(f)) {
+                continue;
+            }
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "%a", static_cast<double>(f));
+            if (!matches_reference<float>(std::string{buf}, std::strtof)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("long double")
+    {
+        std::uniform_int_distribution<int> exp(-16450, 16380);
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto ld = std::ldexp(static_cast<long double>(rng()),
+                                       exp(rng) - 64);
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "%La", ld);
+            if (!matches_reference<long double>(std::string{buf},
+                                               std::strtold)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("rounding")
+    {
+        // Up to 24 digits: more than fit in any significand,
+        // with exponents reaching the subnormal and overflow ranges
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto str = random_hexfloat(rng, 1200);
+            if (!matches_reference<double>(str, std::strtod) ||
+                !matches_reference<float>(str, std::strtof)) {
+                ++mismatches;
+            }
+        }
+        for (int i = 0; i < iterations; ++i) {
+            const auto str = random_hexfloat(rng, 16500);
+            if (!matches_reference<long double>(str, std::strtold)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("ties")
+    {
+        // 1 + 2^-53 is halfway between 1 and the next double
+        CHECK(matches_reference<double>(std::string{"0x1.00000000000008p0"},
+                                       std::strtod));
+        CHECK(matches_reference<double>(std::string{"0x1.00000000000018p0"},
+                                       std::strtod));
+        CHECK(matches_reference<double>(
+            std::string{"0x1.000000000000080000000001p0"}, std::strtod));
+        // Halfway between 0 and the smallest subnormal
+        CHECK(matches_reference<double>(std::string{"0x1p-1075"}, std::strtod));
+        CHECK(matches_reference<double>(std::string{"0x1.1p-1075"},
+                                       std::strtod));
+        CHECK(matches_reference<double>(std::string{"0x1.fffffffffffff8p1023"},
+                                       std::strtod));
+    }
+    SUBCASE("wide")
+    {
+        int mismatches = 0;
+        for (int i = 0; i < iterations / 16; ++i) {
+            const auto narrow = random_hexfloat(rng, 1100);
+            const std::wstring str(narrow.begin(), narrow.end());
+            if (!matches_reference<double>(str, std::wcstod)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("partial")
+    {
+        const std::string inputs[] = {"0xg",      "-0x.p1",  "0x1p",
+                                      "0x1.8p+z", "0X1.8P+1 ", "0x.8p-1x"};
+        for (const auto& str : inputs) {
+            CHECK(matches_reference<double>(str, std::strtod));
+        }
+    }
+}
+
+static std::string random_decimal(std::mt19937_64& rng,
+                                  int max_digits,
+                                  int max_exp)
+{
+    std::uniform_int_distribution<int> ndigits(1, max_digits);
+    std::uniform_int_distribution<int> digit(0, 9);
+    std::uniform_int_distribution<int> exp(-max_exp, max_exp);
+
+    std::string str = rng() % 2 ? "-" : "";
+    const int n = ndigits(rng);
+    const int point = static_cast<int>(rng() % static_cast<unsigned>(n + 1));
+    for (int i = 0; i < n; ++i) {
+        if (i == point) {
+            str += '.';
+        }
+        str += static_cast<char>('0' + digit(rng));
+    }
+    if (rng() % 4 != 0) {
+        str += 'e';
+        str += std::to_string(exp(rng));
+    }
+    return str;
+}
+
+TEST_CASE("long double")
+{
+    std::mt19937_64 rng{1234};
+    const int iterations = 1 << 14;
+
+    SUBCASE("short")
+    {
+        // Mostly within the exact range of the fast path
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto str = random_decimal(rng, 19, 30);
+            if (!matches_reference<long double>(str, std::strtold)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("long")
+    {
+        // Too many digits or too large exponents: the fallback
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto str = random_decimal(rng, 40, 5000);
+            if (!matches_reference<long double>(str, std::strtold)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("special")
+    {
+        const std::string inputs[] = {"0",
+                                      "-0.0",
+                                      "18446744073709551615",
+                                      "18446744073709551616",
+                                      "9007199254740993",
+                                      "0.1",
+                                      "1e27",
+                                      "123456789e-27",
+                                      "inf",
+                                      "-infinity",
+                                      "+1.5",
+                                      ".5e1x"};
+        for (const auto& str : inputs) {
+            CHECK(matches_reference<long double>(str, std::strtold));
+        }
+    }
+}
+
+template <typename T>
+static bool wide_matches_narrow(const std::string& narrow,
+                                const std::wstring& wide)
+{
+    T n{}, w{};
+    auto nret = scn::parse_float(
+        scn::string_view{narrow.data(), narrow.size()}, n);
+    auto wret =
+        scn::parse_float(scn::wstring_view{wide.data(), wide.size()}, w);
+    if (!nret || !wret) {
+        return !nret && !wret && nret.error() == wret.error();
+    }
+    return nret.value() - narrow.data() == wret.value() - wide.data() &&
+           !(n < w) && !(n > w) && std::signbit(n) == std::signbit(w);
+}
+
+TEST_CASE("wide")
+{
+    std::mt19937_64 rng{5678};
+    const int iterations = 1 << 13;
+
+    SUBCASE("random")
+    {
+        // Same results as narrow, including underflow and overflow
+        int mismatches = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto narrow = random_decimal(rng, 24, 400);
+            const std::wstring wide(narrow.begin(), narrow.end());
+            if (!wide_matches_narrow<float>(narrow, wide) ||
+                !wide_matches_narrow<double>(narrow, wide) ||
+                !wide_matches_narrow<long double>(narrow, wide)) {
+                ++mismatches;
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+    SUBCASE("non-ascii")
+    {
+        const std::wstring inputs[] = {L"1.5\u00e9", L"-2e3\u2212",
+                                       L"nan", L"-inf"};
+        for (const auto& str : inputs) {
+            CHECK(matches_reference<double>(str, std::wcstod));
+        }
+
+        double d{};
+        auto ret = scn::parse_float(scn::wstring_view{L"\u00e9"}, d);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("plus sign")
+    {
+        // Accepted like with wcstod
+        const std::wstring inputs[] = {L"+1.5", L"+2e-3", L"+inf", L"+.5"};
+        for (const auto& str : inputs) {
+            CHECK(matches_reference<float>(str, std::wcstof));
+            CHECK(matches_reference<double>(str, std::wcstod));
+            CHECK(matches_reference<long double>(str, std::wcstold));
+        }
+
+        double d{};
+        auto ret = scn::parse_float(scn::wstring_view{L"+-1"}, d);
+        CHECK(!ret);
+        ret = scn::parse_float(scn::wstring_view{L"+"}, d);
+        CHECK(!ret);
+    }
+}
+
+TEST_CASE("strtod fallback from many threads")
+{
+    // These are all parsed by strtod/wcstod (long double, wide, subnormal),
+    // which must not race on the global C locale
+    const std::string narrow[] = {"3.25", "0x1.8p1", "-1.5e-300", "1e4000"};
+    const std::wstring wide[] = {L"2.5", L"0x1p-2", L"6.02e23"};
+    const std::string subnormal = "1.2e-39";
+
+    auto parse_all = [&](std::vector<long double>& out) {
+        long double ld{};
+        for (const auto& s : narrow) {
+            out.push_back(scn::scan(s, "{}", ld) ? ld : -1.0L);
+        }
+        double d{};
+        for (const auto& s : wide) {
+            out.push_back(scn::scan(s, L"{}", d) ? d : -1.0);
+        }
+        float f{};
+        out.push_back(scn::scan(subnormal, "{}", f) ? f : -1.0f);
+    };
+
+    std::vector<long double> expected;
+    parse_all(expected);
+    CHECK(expected[0] == doctest::Approx(3.25));
+    CHECK(expected[1] == doctest::Approx(3.0));
+    CHECK(expected[4] == doctest::Approx(2.5));
+    CHECK(expected[5] == doctest::Approx(0.25));
+
+    const size_t thread_count = 8;
+    const int iterations = 500;
+    std::vector<int> mismatches(thread_count, 0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<long double> got;
+            for (int i = 0; i < iterations; ++i) {
+                got.clear();
+                parse_all(got);
+                if (got != expected) {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    for (size_t t = 0; t < thread_count; ++t) {
+        CHECK(mismatches[t] == 0);
+    }
+}
+
 TEST_CASE("consistency")
 {
     SUBCASE("simple")
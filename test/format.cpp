@@ -137,6 +137,52 @@ TEST_CASE("width")
         CHECK(e.empty());
         CHECK(i == 123);
     }
+    SUBCASE("float over")
+    {
+        double d;
+        auto e = scn::scan("1.2345", "{:4}", d);
+        CHECK(e);
+        CHECK(e.range_as_string() == "45");
+        CHECK(d == doctest::Approx(1.23));
+    }
+    SUBCASE("float under")
+    {
+        double d;
+        auto e = scn::scan("1.5", "{:8}", d);
+        CHECK(e);
+        CHECK(e.empty());
+        CHECK(d == doctest::Approx(1.5));
+    }
+    SUBCASE("int columns")
+    {
+        int a, b, c;
+        auto e = scn::scan("   12345-1234567  42", "{:8}{:8}{:4}", a, b, c);
+        CHECK(e);
+        CHECK(e.empty());
+        CHECK(a == 12345);
+        CHECK(b == -1234567);
+        CHECK(c == 42);
+
+        e = scn::scan("1234567812345678", "{:8}{:8}", a, b);
+        CHECK(e);
+        CHECK(a == 12345678);
+        CHECK(b == 12345678);
+    }
+    SUBCASE("float columns")
+    {
+        double a, b, c;
+        auto e = scn::scan("  1.25e2-0.00125  3.5", "{:8}{:8}{:4}", a, b, c);
+        CHECK(e);
+        CHECK(e.empty());
+        CHECK(a == doctest::Approx(125.0));
+        CHECK(b == doctest::Approx(-0.00125));
+        CHECK(c == doctest::Approx(3.5));
+
+        e = scn::scan("1.5 2.25", "{:4}{:4}", a, b);
+        CHECK(e);
+        CHECK(a == doctest::Approx(1.5));
+        CHECK(b == doctest::Approx(2.25));
+    }
 }
 
 TEST_CASE("utf8 literal")
@@ -527,6 +527,183 @@ TEST_CASE("integer thousands separator")
         CHECK(ret);
         CHECK(a == 100200);
     }
+    SUBCASE("several separators")
+    {
+        auto ret = scn::scan("-1,234,567 2,147,483,647", "{:'} {:'}", a, b);
+        CHECK(ret);
+        CHECK(a == -1234567);
+        CHECK(b == 2147483647);
+
+        ret = scn::scan("2,147,483,648", "{:'}", a);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+    }
+    SUBCASE("invalid grouping")
+    {
+        auto ret = scn::scan("1,23,456", "{:'}", a);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+
+        ret = scn::scan("1234,567", "{:'}", a);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("separator after the number")
+    {
+        auto ret = scn::scan("1,234,", "{:'}", a);
+        CHECK(ret);
+        CHECK(a == 1234);
+        CHECK(ret.range_as_string() == ",");
+
+        ret = scn::scan("12,,345", "{:'}", a);
+        CHECK(ret);
+        CHECK(a == 12);
+        CHECK(ret.range_as_string() == ",,345");
+
+        ret = scn::scan(",123", "{:'}", a);
+        CHECK(!ret);
+    }
+    SUBCASE("non-contiguous")
+    {
+        auto source = get_deque<wchar_t>(L"1,234,567 89");
+        auto ret = scn::scan(source, L"{:'} {}", a, b);
+        CHECK(ret);
+        CHECK(a == 1234567);
+        CHECK(b == 89);
+    }
+}
+
+TEST_CASE_TEMPLATE("non-contiguous", CharT, char, wchar_t)
+{
+    auto src = get_deque<CharT>(
+        widen<CharT>("-9223372036854775808 0b1111 1,234 "
+                     "0000000000000000000000000000000000042"));
+    long long i{};
+    auto ret = scn::scan(src, widen<CharT>("{}"), i);
+    CHECK(ret);
+    CHECK(i == std::numeric_limits<long long>::min());
+
+    unsigned u{};
+    ret = scn::scan(ret.range(), widen<CharT>("{:b} {:'}"), u, i);
+    CHECK(ret);
+    CHECK(u == 15);
+    CHECK(i == 1234);
+
+    ret = scn::scan(ret.range(), widen<CharT>("{}"), u);
+    CHECK(ret);
+    CHECK(u == 42);
+
+    // Longer than any valid literal, even with leading zeroes
+    src = get_deque<CharT>(std::basic_string<CharT>(200, CharT{'1'}));
+    ret = scn::scan(src, widen<CharT>("{}"), i);
+    CHECK(!ret);
+    CHECK(ret.error() == scn::error::value_out_of_range);
+}
+
+TEST_CASE("integer_format")
+{
+    SUBCASE("hex")
+    {
+        unsigned a{}, b{};
+        auto ret = scn::scan(
+            "ff 0x10", scn::integer_format<16, scn::integer_format_prefix>{},
+            a, b);
+        CHECK(ret);
+        CHECK(ret.empty());
+        CHECK(a == 255);
+        CHECK(b == 16);
+
+        // Without integer_format_prefix, "0x" stops at the 'x'
+        ret = scn::scan("0x10", scn::integer_format<16>{}, a);
+        CHECK(ret);
+        CHECK(a == 0);
+        CHECK(ret.range_as_string() == "x10");
+    }
+    SUBCASE("mixed types")
+    {
+        short s{};
+        long long ll{};
+        unsigned char uc{};
+        auto ret = scn::scan("  -123\n9223372036854775807 255 rest",
+                             scn::integer_format<10>{}, s, ll, uc);
+        CHECK(ret);
+        CHECK(s == -123);
+        CHECK(ll == std::numeric_limits<long long>::max());
+        CHECK(uc == 255);
+        CHECK(ret.range_as_string() == " rest");
+    }
+    SUBCASE("unsigned")
+    {
+        int i{};
+        auto ret = scn::scan("-1", scn::integer_format<10>{}, i);
+        CHECK(ret);
+        CHECK(i == -1);
+
+        ret = scn::scan(
+            "-1", scn::integer_format<10, scn::integer_format_unsigned>{}, i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("binary and octal")
+    {
+        int a{}, b{};
+        auto ret = scn::scan(
+            "0b101 -17", scn::integer_format<2, scn::integer_format_prefix>{},
+            a);
+        CHECK(ret);
+        CHECK(a == 5);
+        ret = scn::scan(ret.range(), scn::integer_format<8>{}, b);
+        CHECK(ret);
+        CHECK(b == -15);
+    }
+    SUBCASE("errors roll back")
+    {
+        int a{}, b{};
+        auto ret = scn::scan("1 2147483648", scn::integer_format<10>{}, a, b);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+        CHECK(ret.range_as_string() == "1 2147483648");
+
+        ret = scn::scan("1", scn::integer_format<10>{}, a, b);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::end_of_range);
+    }
+    SUBCASE("same as format string")
+    {
+        const char* sources[] = {"0",          "-0",          "+42",
+                                 "0x7fffffff", "-0x80000000", "0x80000000",
+                                 "x",          "fFfF",        "-",
+                                 "0x"};
+        for (auto str : sources) {
+            auto source = scn::string_view{str};
+            int expected{}, i{};
+            auto expected_ret = scn::scan(source, "{:x}", expected);
+            auto ret = scn::scan(
+                source, scn::integer_format<16, scn::integer_format_prefix>{},
+                i);
+            CHECK(bool(ret) == bool(expected_ret));
+            CHECK(ret.range_as_string() == expected_ret.range_as_string());
+            if (ret) {
+                CHECK(i == expected);
+            }
+            else {
+                CHECK(ret.error() == expected_ret.error());
+            }
+        }
+    }
+}
+
+TEST_CASE_TEMPLATE("integer_format non-contiguous", CharT, char, wchar_t)
+{
+    auto src = get_deque<CharT>(widen<CharT>("-9223372036854775808 ff"));
+    long long i{};
+    unsigned u{};
+    auto ret = scn::scan(src, scn::integer_format<10>{}, i);
+    CHECK(ret);
+    CHECK(i == std::numeric_limits<long long>::min());
+    ret = scn::scan(ret.range(), scn::integer_format<16>{}, u);
+    CHECK(ret);
+    CHECK(u == 255);
 }
 
 TEST_CASE("parse_integer")
@@ -585,6 +762,94 @@ TEST_CASE("parse_integer")
     }
 }
 
+TEST_CASE("parse_integers")
+{
+    std::vector<int> values(8);
+    auto out = scn::make_span(values);
+
+    SUBCASE("whitespace separated")
+    {
+        scn::string_view source{"  1 -23\n456\t\t7890  "};
+        auto ret = scn::parse_integers(source, out);
+        CHECK(ret);
+        CHECK(ret.count == 4);
+        CHECK(ret.ptr == source.end());
+        CHECK(values[0] == 1);
+        CHECK(values[1] == -23);
+        CHECK(values[2] == 456);
+        CHECK(values[3] == 7890);
+    }
+    SUBCASE("output full")
+    {
+        scn::string_view source{"1 2 3 4"};
+        auto ret = scn::parse_integers(source, out.first(2));
+        CHECK(ret);
+        CHECK(ret.count == 2);
+        CHECK(ret.ptr == source.begin() + 4);
+        CHECK(values[1] == 2);
+    }
+    SUBCASE("empty")
+    {
+        scn::string_view source{"   "};
+        auto ret = scn::parse_integers(source, out);
+        CHECK(ret);
+        CHECK(ret.count == 0);
+        CHECK(ret.ptr == source.end());
+    }
+    SUBCASE("invalid value")
+    {
+        scn::string_view source{"12 34abc 56"};
+        auto ret = scn::parse_integers(source, out);
+        CHECK(!ret);
+        CHECK(ret.err == scn::error::invalid_scanned_value);
+        CHECK(ret.count == 1);
+        CHECK(ret.ptr == source.begin() + 3);
+
+        source = "1 - 2";
+        ret = scn::parse_integers(source, out);
+        CHECK(!ret);
+        CHECK(ret.count == 1);
+        CHECK(ret.ptr == source.begin() + 2);
+    }
+    SUBCASE("out of range")
+    {
+        scn::string_view source{"1 99999999999 2"};
+        auto ret = scn::parse_integers(source, out);
+        CHECK(!ret);
+        CHECK(ret.err == scn::error::value_out_of_range);
+        CHECK(ret.count == 1);
+        CHECK(ret.ptr == source.begin() + 2);
+    }
+    SUBCASE("separator and base")
+    {
+        scn::string_view source{"ff, 10 ,7f,0"};
+        auto ret = scn::parse_integers(
+            source, out, scn::parse_integers_options<char>{16, ','});
+        CHECK(ret);
+        CHECK(ret.count == 4);
+        CHECK(values[0] == 255);
+        CHECK(values[1] == 16);
+        CHECK(values[2] == 127);
+        CHECK(values[3] == 0);
+
+        source = "1, 2,";
+        ret = scn::parse_integers(
+            source, out, scn::parse_integers_options<char>{10, ','});
+        CHECK(!ret);
+        CHECK(ret.count == 2);
+    }
+    SUBCASE("wide")
+    {
+        std::vector<long long> wide_values(2);
+        scn::wstring_view source{L"123 -456"};
+        auto ret =
+            scn::parse_integers(source, scn::make_span(wide_values));
+        CHECK(ret);
+        CHECK(ret.count == 2);
+        CHECK(wide_values[1] == -456);
+    }
+}
+
 template <typename T>
 T maxval()
 {
@@ -837,6 +1102,333 @@ TEST_CASE("trailing")
     CHECK(ret.range_as_string_view()[0] == ';');
 }
 
+TEST_CASE("long digit runs")
+{
+    // Digits are parsed eight at a time where possible:
+    // check every length and every position of a terminating non-digit
+    const std::string digits = "98765432109876543210";
+    for (std::size_t len = 1; len <= digits.size(); ++len) {
+        const auto source = digits.substr(0, len);
+        const auto expected = std::strtoull(source.c_str(), nullptr, 10);
+        const bool fits = len < 20;
+
+        const auto trailing = source + "x1234567";
+        unsigned long long u{};
+        auto uret = scn::scan_default(trailing, u);
+        CHECK(static_cast<bool>(uret) == fits);
+        if (fits) {
+            CHECK(u == expected);
+            CHECK(uret.range().size() == 8);
+        }
+        else {
+            CHECK(uret.error() == scn::error::value_out_of_range);
+        }
+
+        const auto negative = "-" + source;
+        long long i{};
+        auto iret = scn::scan_default(negative, i);
+        CHECK(static_cast<bool>(iret) == (len < 19));
+        if (len < 19) {
+            CHECK(i == -static_cast<long long>(expected));
+        }
+
+        int j{};
+        auto jret = scn::scan_default(source, j);
+        CHECK(static_cast<bool>(jret) == (len < 10));
+        if (len < 10) {
+            CHECK(j == static_cast<int>(expected));
+        }
+    }
+
+    SUBCASE("leading zeroes")
+    {
+        unsigned u{};
+        auto ret = scn::scan("0000000000000000000000004294967295", "{:d}", u);
+        CHECK(ret);
+        CHECK(u == 4294967295u);
+
+        ret = scn::scan("0000000000000000000000004294967296", "{:d}", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+    }
+    SUBCASE("limits")
+    {
+        long long i{};
+        auto ret = scn::scan_default("9223372036854775807", i);
+        CHECK(ret);
+        CHECK(i == std::numeric_limits<long long>::max());
+        ret = scn::scan_default("9223372036854775808", i);
+        CHECK(!ret);
+        ret = scn::scan_default("-9223372036854775808", i);
+        CHECK(ret);
+        CHECK(i == std::numeric_limits<long long>::min());
+        ret = scn::scan_default("-9223372036854775809", i);
+        CHECK(!ret);
+
+        unsigned long long u{};
+        ret = scn::scan_default("18446744073709551615", u);
+        CHECK(ret);
+        CHECK(u == std::numeric_limits<unsigned long long>::max());
+        ret = scn::scan_default("18446744073709551616", u);
+        CHECK(!ret);
+    }
+    SUBCASE("power-of-two bases")
+    {
+        int i{};
+        auto ret = scn::scan("7fffffff", "{:x}", i);
+        CHECK(ret);
+        CHECK(i == std::numeric_limits<int>::max());
+        ret = scn::scan("80000000", "{:x}", i);
+        CHECK(!ret);
+        ret = scn::scan("-80000000", "{:x}", i);
+        CHECK(ret);
+        CHECK(i == std::numeric_limits<int>::min());
+        ret = scn::scan("100000000", "{:x}", i);
+        CHECK(!ret);
+
+        unsigned long long u{};
+        ret = scn::scan("1777777777777777777777", "{:o}", u);
+        CHECK(ret);
+        CHECK(u == std::numeric_limits<unsigned long long>::max());
+        ret = scn::scan("2000000000000000000000", "{:o}", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        unsigned short s{};
+        ret = scn::scan("1111111111111111", "{:b}", s);
+        CHECK(ret);
+        CHECK(s == 65535);
+        ret = scn::scan("00010000000000000000", "{:b}", s);
+        CHECK(!ret);
+    }
+}
+
+TEST_CASE("long hex and binary digit runs")
+{
+    // Hex and binary digits are also parsed eight at a time
+    const std::string hex = "fEdCbA9876543210";
+    for (std::size_t len = 1; len <= hex.size(); ++len) {
+        const auto source = hex.substr(0, len);
+        const auto expected = std::strtoull(source.c_str(), nullptr, 16);
+
+        unsigned long long u{};
+        auto ret = scn::scan(source + "g1234567", "{:x}", u);
+        CHECK(ret);
+        CHECK(u == expected);
+        CHECK(ret.range().size() == 8);
+
+        ret = scn::scan("0x" + source, "{:x}", u);
+        CHECK(ret);
+        CHECK(u == expected);
+
+        ret = scn::scan("0X" + source, "{:i}", u);
+        CHECK(ret);
+        CHECK(u == expected);
+    }
+
+    const std::string bin =
+        "1101001011110000101101001110001111000011101001011001011010110111";
+    for (std::size_t len = 1; len <= bin.size(); ++len) {
+        const auto source = bin.substr(0, len);
+        const auto expected = std::strtoull(source.c_str(), nullptr, 2);
+
+        unsigned long long u{};
+        auto ret = scn::scan(source + "21111111", "{:b}", u);
+        CHECK(ret);
+        CHECK(u == expected);
+        CHECK(ret.range().size() == 8);
+
+        ret = scn::scan("0b" + source, "{:b}", u);
+        CHECK(ret);
+        CHECK(u == expected);
+
+        ret = scn::scan("0B" + source, "{:i}", u);
+        CHECK(ret);
+        CHECK(u == expected);
+    }
+
+    SUBCASE("every character")
+    {
+        // Only actual digits are accepted in the middle of a group
+        for (int ch = 1; ch < 256; ++ch) {
+            std::string source = "12345678";
+            source[3] = static_cast<char>(ch);
+            const auto c = static_cast<char>(ch);
+            const bool hex_digit = (c >= '0' && c <= '9') ||
+                                   (c >= 'a' && c <= 'f') ||
+                                   (c >= 'A' && c <= 'F');
+            const bool bin_digit = c == '0' || c == '1';
+
+            unsigned long long u{};
+            auto ret = scn::scan(source, "{:x}", u);
+            CHECK(ret);
+            CHECK(u == std::strtoull(source.c_str(), nullptr, 16));
+            CHECK(ret.range().size() == (hex_digit ? 0 : 5));
+
+            source = "10110110";
+            source[3] = static_cast<char>(ch);
+            ret = scn::scan(source, "{:b}", u);
+            CHECK(ret);
+            CHECK(ret.range().size() == (bin_digit ? 0 : 5));
+        }
+    }
+    SUBCASE("limits")
+    {
+        unsigned long long u{};
+        auto ret = scn::scan("0x1ffffffffffffffff", "{:x}", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+        const auto too_long = "0b" + std::string(65, '1');
+        ret = scn::scan(too_long, "{:b}", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        unsigned v{};
+        ret = scn::scan("0xFFFFFFFF", "{:x}", v);
+        CHECK(ret);
+        CHECK(v == 0xffffffffu);
+        ret = scn::scan("0x100000000", "{:x}", v);
+        CHECK(!ret);
+    }
+}
+
+#if SCN_HAS_INT128
+static scn::uint128 parse_uint128_naive(const std::string& s, unsigned base)
+{
+    scn::uint128 val = 0;
+    for (auto ch : s) {
+        const auto digit = ch <= '9' ? static_cast<unsigned>(ch - '0')
+                                     : static_cast<unsigned>(ch - 'a' + 10);
+        val = val * base + digit;
+    }
+    return val;
+}
+
+TEST_CASE("128-bit integers")
+{
+    const std::string int128_max = "170141183460469231731687303715884105727";
+    const std::string uint128_max = "340282366920938463463374607431768211455";
+
+    SUBCASE("every length")
+    {
+        // First 19 digits are parsed in 64 bits, the rest in 128
+        for (std::size_t len = 1; len <= int128_max.size(); ++len) {
+            const auto source = int128_max.substr(0, len);
+            const auto expected = parse_uint128_naive(source, 10);
+
+            scn::uint128 u{};
+            auto ret = scn::scan(source + " 1", "{}", u);
+            CHECK(ret);
+            CHECK(u == expected);
+            CHECK(ret.range().size() == 2);
+
+            scn::int128 i{};
+            ret = scn::scan("-" + source, "{}", i);
+            CHECK(ret);
+            CHECK(i == -static_cast<scn::int128>(expected));
+        }
+    }
+    SUBCASE("limits")
+    {
+        scn::int128 i{};
+        auto ret = scn::scan_default(std::string{int128_max}, i);
+        CHECK(ret);
+        CHECK(static_cast<scn::uint128>(i) ==
+              parse_uint128_naive(int128_max, 10));
+
+        ret = scn::scan_default(
+            std::string{"170141183460469231731687303715884105728"}, i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_default(
+            std::string{"-170141183460469231731687303715884105728"}, i);
+        CHECK(ret);
+        CHECK(i == -static_cast<scn::int128>(
+                       parse_uint128_naive(int128_max, 10)) -
+                       1);
+
+        ret = scn::scan_default(
+            std::string{"-170141183460469231731687303715884105729"}, i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        scn::uint128 u{};
+        ret = scn::scan_default(std::string{uint128_max}, u);
+        CHECK(ret);
+        CHECK(u == static_cast<scn::uint128>(-1));
+
+        ret = scn::scan_default(
+            std::string{"340282366920938463463374607431768211456"}, u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_default(uint128_max + "0", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_default(std::string{"-1"}, u);
+        CHECK(!ret);
+
+        ret = scn::scan("00000000000000000000000000" + uint128_max, "{:d}", u);
+        CHECK(ret);
+        CHECK(u == static_cast<scn::uint128>(-1));
+    }
+    SUBCASE("hex and binary")
+    {
+        const std::string hex = "fedcba9876543210fedcba9876543210";
+        for (std::size_t len = 1; len <= hex.size(); ++len) {
+            const auto source = hex.substr(0, len);
+
+            scn::uint128 u{};
+            auto ret = scn::scan("0x" + source, "{:x}", u);
+            CHECK(ret);
+            CHECK(u == parse_uint128_naive(source, 16));
+        }
+
+        scn::uint128 u{};
+        auto ret = scn::scan("0x1" + std::string(32, '0'), "{:x}", u);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan("0b" + std::string(128, '1'), "{:b}", u);
+        CHECK(ret);
+        CHECK(u == static_cast<scn::uint128>(-1));
+
+        ret = scn::scan("0b" + std::string(129, '1'), "{:b}", u);
+        CHECK(!ret);
+
+        ret = scn::scan("0o" + std::string(42, '7'), "{:o}", u);
+        CHECK(ret);
+        CHECK(u == parse_uint128_naive(std::string(42, '7'), 8));
+    }
+    SUBCASE("thousands separator")
+    {
+        scn::int128 i{};
+        auto ret = scn::scan("-18,446,744,073,709,551,616", "{:'}", i);
+        CHECK(ret);
+        CHECK(i == -static_cast<scn::int128>(
+                       parse_uint128_naive("18446744073709551616", 10)));
+
+        // A leading group of 257 digits is too long,
+        // its size mustn't wrap around to 1
+        scn::uint128 u{};
+        auto long_ret =
+            scn::scan(std::string(256, '0') + "1,234", "{:'}", u);
+        CHECK(!long_ret);
+        CHECK(long_ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("wide")
+    {
+        scn::uint128 u{};
+        auto ret = scn::scan_default(
+            L"340282366920938463463374607431768211455", u);
+        CHECK(ret);
+        CHECK(u == static_cast<scn::uint128>(-1));
+    }
+}
+#endif
+
 TEST_CASE("consistency")
 {
     SUBCASE("simple")
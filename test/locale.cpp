@@ -226,3 +226,108 @@ TEST_CASE("default localized scanning")
         CHECK(d == doctest::Approx(100.2));
     }
 }
+
+namespace {
+    template <typename CharT>
+    struct grouping_numpunct : std::numpunct<CharT> {
+        CharT do_thousands_sep() const override
+        {
+            return static_cast<CharT>('.');
+        }
+        std::string do_grouping() const override
+        {
+            return "\3\2";
+        }
+    };
+}  // namespace
+
+TEST_CASE_TEMPLATE("localized digits", CharT, char, wchar_t)
+{
+    auto loc = std::locale(std::locale::classic(),
+                           new grouping_numpunct<CharT>{});
+    long long i{};
+
+    SUBCASE("grouped")
+    {
+        auto ret =
+            scn::scan_localized(loc, widen<CharT>("-12.34.567 8"),
+                                widen<CharT>("{:n}"), i);
+        CHECK(ret);
+        CHECK(i == -1234567);
+        CHECK(ret.range().size() == 2);
+    }
+    SUBCASE("ungrouped")
+    {
+        auto ret = scn::scan_localized(loc, widen<CharT>("1234567"),
+                                       widen<CharT>("{:n}"), i);
+        CHECK(ret);
+        CHECK(i == 1234567);
+    }
+    SUBCASE("trailing separator")
+    {
+        auto ret = scn::scan_localized(loc, widen<CharT>("1.234."),
+                                       widen<CharT>("{:n}"), i);
+        CHECK(ret);
+        CHECK(i == 1234);
+        CHECK(ret.range().size() == 1);
+    }
+    SUBCASE("invalid grouping")
+    {
+        auto ret = scn::scan_localized(loc, widen<CharT>("1.2345.678"),
+                                       widen<CharT>("{:n}"), i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+
+        ret = scn::scan_localized(loc, widen<CharT>("123.4567"),
+                                  widen<CharT>("{:n}"), i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+    }
+    SUBCASE("hex")
+    {
+        auto ret = scn::scan_localized(loc, widen<CharT>("0x1.fff"),
+                                       widen<CharT>("{:nx}"), i);
+        CHECK(ret);
+        CHECK(i == 0x1fff);
+    }
+    SUBCASE("base")
+    {
+        // Only bases 8, 10 and 16, like with non-ASCII digits
+        auto ret = scn::scan_localized(loc, widen<CharT>("101"),
+                                       widen<CharT>("{:nb}"), i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_format_string);
+
+        ret = scn::scan_localized(loc, widen<CharT>("0b101"),
+                                  widen<CharT>("{:ni}"), i);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::invalid_scanned_value);
+
+        ret = scn::scan_localized(loc, widen<CharT>("0x1f"),
+                                  widen<CharT>("{:ni}"), i);
+        CHECK(ret);
+        CHECK(i == 0x1f);
+    }
+    SUBCASE("out of range")
+    {
+        int j{};
+        auto ret = scn::scan_localized(loc, widen<CharT>("2.14.74.83.648"),
+                                       widen<CharT>("{:n}"), j);
+        CHECK(!ret);
+        CHECK(ret.error() == scn::error::value_out_of_range);
+
+        ret = scn::scan_localized(loc, widen<CharT>("-2.14.74.83.648"),
+                                  widen<CharT>("{:n}"), j);
+        CHECK(ret);
+        CHECK(j == std::numeric_limits<int>::min());
+    }
+    SUBCASE("classic locale")
+    {
+        // No grouping: separators aren't accepted
+        auto ret = scn::scan_localized(std::locale::classic(),
+                                       widen<CharT>("1,234"),
+                                       widen<CharT>("{:n}"), i);
+        CHECK(ret);
+        CHECK(i == 1);
+    }
+}
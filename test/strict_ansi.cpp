@@ -0,0 +1,42 @@
+// Copyright 2017 Elias Kosunen
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This file is a part of scnlib:
+//     https://github.com/eliaskosunen/scnlib
+
+// Built in strict ISO mode (no GNU extensions), against the library built
+// with the compiler's default mode: SCN_HAS_INT128 may differ between the
+// two, which mustn't change the types of the other arguments
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "test.h"
+
+TEST_CASE("strict ansi")
+{
+    unsigned u{};
+    double d{};
+    std::string s{};
+    auto ret = scn::scan("42 3.5 str", "{} {} {}", u, d, s);
+    CHECK(ret);
+    CHECK(u == 42);
+    CHECK(d == doctest::Approx(3.5));
+    CHECK(s == "str");
+
+    long long ll{};
+    bool b{};
+    ret = scn::scan("-1 true", "{} {}", ll, b);
+    CHECK(ret);
+    CHECK(ll == -1);
+    CHECK(b);
+}